@@ -0,0 +1,366 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: ArchipelagoGrid.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../src/iso/Asset.hpp"
+#include "../src/iso/IsoMath.hpp"
+#include "../src/iso/MapFieldChunks.hpp"
+#include "../src/iso/ConnectedComponents.hpp"
+#include "../src/iso/ClearanceMap.hpp"
+#include "../src/iso/LandmarkTable.hpp"
+
+namespace sg::islands::bench
+{
+    struct ArchipelagoOptions
+    {
+        /**
+         * @brief The size in map fields.
+         */
+        int width{ 256 };
+        int height{ 256 };
+
+        int numberOfIslands{ 12 };
+
+        /**
+         * @brief The part of the map covered by land, from 0 to 1.
+         */
+        float density{ 0.3f };
+
+        std::uint32_t seed{ 1 };
+
+        /**
+         * @brief The number of landmarks per unit type for the ALT heuristic.
+         */
+        int numberOfLandmarks{ iso::LandmarkTable::DEFAULT_NUMBER_OF_LANDMARKS };
+    };
+
+    /**
+     * @brief A procedurally generated sea with islands that can be searched like a `Map`.
+     *        The islands grow from random seeds and never touch each other, so each island is
+     *        its own land region. No file, texture or window is needed.
+     */
+    class ArchipelagoGrid
+    {
+    public:
+        static constexpr int NO_ISLAND{ -1 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        ArchipelagoGrid() = delete;
+
+        explicit ArchipelagoGrid(const ArchipelagoOptions& t_options)
+            : m_mapWidth{ t_options.width }
+            , m_mapHeight{ t_options.height }
+        {
+            assert(m_mapWidth > 2 && m_mapHeight > 2);
+
+            GenerateIslands(t_options);
+            GenerateWalkability();
+
+            m_waterComponents.Build(m_mapWidth, m_mapHeight, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, iso::AssetType::WATER_UNIT);
+            });
+
+            m_landComponents.Build(m_mapWidth, m_mapHeight, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, iso::AssetType::LAND_UNIT);
+            });
+
+            m_waterClearance.Build(m_mapWidth, m_mapHeight, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, iso::AssetType::WATER_UNIT);
+            });
+
+            m_landClearance.Build(m_mapWidth, m_mapHeight, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, iso::AssetType::LAND_UNIT);
+            });
+
+            m_waterLandmarks.Build(m_mapWidth, m_mapHeight, t_options.numberOfLandmarks, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, iso::AssetType::WATER_UNIT);
+            });
+
+            m_landLandmarks.Build(m_mapWidth, m_mapHeight, t_options.numberOfLandmarks, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, iso::AssetType::LAND_UNIT);
+            });
+        }
+
+        ArchipelagoGrid(const ArchipelagoGrid& t_other) = delete;
+        ArchipelagoGrid(ArchipelagoGrid&& t_other) noexcept = delete;
+        ArchipelagoGrid& operator=(const ArchipelagoGrid& t_other) = delete;
+        ArchipelagoGrid& operator=(ArchipelagoGrid&& t_other) noexcept = delete;
+
+        ~ArchipelagoGrid() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        auto GetMapWidth() const { return m_mapWidth; }
+
+        auto GetMapHeight() const { return m_mapHeight; }
+
+        /**
+         * @brief Get the number of map fields covered by land.
+         * @return std::size_t
+         */
+        std::size_t GetNumberOfLandFields() const noexcept { return m_numberOfLandFields; }
+
+        /**
+         * @brief Get the island of a map field.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @return int The island index or `NO_ISLAND` for deep water.
+         */
+        int GetIsland(const int t_mapX, const int t_mapY) const
+        {
+            return m_islands[iso::IsoMath::From2DTo1D(t_mapX, t_mapY, m_mapWidth)];
+        }
+
+        /**
+         * @brief Get the landmark distances for the given type of unit.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return const iso::LandmarkTable* or nullptr if the landmarks are disabled.
+         */
+        const iso::LandmarkTable* GetLandmarks(const iso::AssetType t_assetType) const
+        {
+            if (!m_landmarksEnabled)
+            {
+                return nullptr;
+            }
+
+            return t_assetType == iso::AssetType::WATER_UNIT ? &m_waterLandmarks : &m_landLandmarks;
+        }
+
+        /**
+         * @brief Checks if a unit of the given type can enter the target.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return bool
+         */
+        bool IsWalkable(const int t_mapX, const int t_mapY, const iso::AssetType t_assetType) const
+        {
+            if (t_mapX < 0 || t_mapY < 0 || t_mapX >= m_mapWidth || t_mapY >= m_mapHeight)
+            {
+                return false;
+            }
+
+            assert(t_assetType == iso::AssetType::WATER_UNIT || t_assetType == iso::AssetType::LAND_UNIT);
+
+            // the same bits as in `Map`
+            return m_fields.IsWalkable(t_mapX, t_mapY, t_assetType);
+        }
+
+        /**
+         * @brief Checks if a unit of the given type and size can stand on the target.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields; the unit is centered on the target.
+         * @return bool
+         */
+        bool IsWalkable(const int t_mapX, const int t_mapY, const iso::AssetType t_assetType, const int t_footprint) const
+        {
+            if (t_footprint <= 1)
+            {
+                return IsWalkable(t_mapX, t_mapY, t_assetType);
+            }
+
+            const auto& clearance{ t_assetType == iso::AssetType::WATER_UNIT ? m_waterClearance : m_landClearance };
+
+            return clearance.Fits(t_mapX, t_mapY, t_footprint);
+        }
+
+        /**
+         * @brief Checks in O(1) if a unit of the given type can get from one position to another.
+         * @param t_from The start map position.
+         * @param t_to The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return bool
+         */
+        bool IsReachable(const sf::Vector2i& t_from, const sf::Vector2i& t_to, const iso::AssetType t_assetType) const
+        {
+            if (!IsWalkable(t_from.x, t_from.y, t_assetType) || !IsWalkable(t_to.x, t_to.y, t_assetType))
+            {
+                return false;
+            }
+
+            const auto& components{ t_assetType == iso::AssetType::WATER_UNIT ? m_waterComponents : m_landComponents };
+
+            return components.IsConnected(t_from.x, t_from.y, t_to.x, t_to.y);
+        }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        void SetLandmarksEnabled(const bool t_landmarksEnabled) { m_landmarksEnabled = t_landmarksEnabled; }
+
+    protected:
+
+    private:
+        int m_mapWidth{ 0 };
+        int m_mapHeight{ 0 };
+
+        /**
+         * @brief The island index per map field.
+         */
+        std::vector<int> m_islands;
+
+        std::size_t m_numberOfLandFields{ 0 };
+
+        iso::MapFieldChunks m_fields;
+
+        iso::ConnectedComponents m_waterComponents;
+        iso::ConnectedComponents m_landComponents;
+        iso::ClearanceMap m_waterClearance;
+        iso::ClearanceMap m_landClearance;
+        iso::LandmarkTable m_waterLandmarks;
+        iso::LandmarkTable m_landLandmarks;
+
+        bool m_landmarksEnabled{ false };
+
+        //-------------------------------------------------
+        // Generate
+        //-------------------------------------------------
+
+        /**
+         * @brief Grows each island from a random seed by adding random neighbours of its fields.
+         *        A field next to another island is skipped, so the islands stay apart.
+         */
+        void GenerateIslands(const ArchipelagoOptions& t_options)
+        {
+            m_islands.assign(static_cast<std::size_t>(m_mapWidth * m_mapHeight), NO_ISLAND);
+
+            if (t_options.numberOfIslands <= 0 || t_options.density <= 0.0f)
+            {
+                return;
+            }
+
+            std::mt19937 random{ t_options.seed };
+            std::uniform_int_distribution<int> xDistribution{ 1, m_mapWidth - 2 };
+            std::uniform_int_distribution<int> yDistribution{ 1, m_mapHeight - 2 };
+
+            const auto landFields{ static_cast<std::size_t>(std::min(t_options.density, 1.0f) * m_mapWidth * m_mapHeight) };
+            const auto fieldsPerIsland{ std::max<std::size_t>(landFields / t_options.numberOfIslands, 1) };
+
+            const std::array<sf::Vector2i, 4> directions{ {
+                { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }
+            } };
+
+            std::vector<int> fields;
+
+            for (auto island{ 0 }; island < t_options.numberOfIslands; ++island)
+            {
+                // find a seed in open water
+                sf::Vector2i seed;
+                auto foundSeed{ false };
+                for (auto attempt{ 0 }; attempt < 100 && !foundSeed; ++attempt)
+                {
+                    seed = sf::Vector2i(xDistribution(random), yDistribution(random));
+                    foundSeed = CanGrow(seed.x, seed.y, island);
+                }
+
+                if (!foundSeed)
+                {
+                    continue;
+                }
+
+                fields.clear();
+                AddLand(seed.x, seed.y, island, fields);
+
+                // the attempts are limited, because an island can be enclosed by its neighbours
+                for (std::size_t attempt{ 0 }; attempt < fieldsPerIsland * 20 && fields.size() < fieldsPerIsland; ++attempt)
+                {
+                    const auto index{ fields[std::uniform_int_distribution<std::size_t>{ 0, fields.size() - 1 }(random)] };
+                    const auto& direction{ directions[std::uniform_int_distribution<std::size_t>{ 0, directions.size() - 1 }(random)] };
+
+                    const auto x{ index % m_mapWidth + direction.x };
+                    const auto y{ index / m_mapWidth + direction.y };
+
+                    if (CanGrow(x, y, island))
+                    {
+                        AddLand(x, y, island, fields);
+                    }
+                }
+            }
+        }
+
+        void GenerateWalkability()
+        {
+            m_fields.Resize(m_mapWidth, m_mapHeight);
+
+            for (auto y{ 0 }; y < m_mapHeight; ++y)
+            {
+                for (auto x{ 0 }; x < m_mapWidth; ++x)
+                {
+                    if (GetIsland(x, y) != NO_ISLAND)
+                    {
+                        m_fields.SetLand(x, y, 0);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Checks if an island can grow onto a field: deep water, not on the map border
+         *        and no other island around.
+         */
+        bool CanGrow(const int t_mapX, const int t_mapY, const int t_island) const
+        {
+            if (t_mapX < 1 || t_mapY < 1 || t_mapX >= m_mapWidth - 1 || t_mapY >= m_mapHeight - 1)
+            {
+                return false;
+            }
+
+            if (GetIsland(t_mapX, t_mapY) != NO_ISLAND)
+            {
+                return false;
+            }
+
+            for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+            {
+                for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                {
+                    const auto island{ GetIsland(t_mapX + xOffset, t_mapY + yOffset) };
+                    if (island != NO_ISLAND && island != t_island)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void AddLand(const int t_mapX, const int t_mapY, const int t_island, std::vector<int>& t_fields)
+        {
+            const auto index{ iso::IsoMath::From2DTo1D(t_mapX, t_mapY, m_mapWidth) };
+
+            m_islands[index] = t_island;
+            t_fields.push_back(index);
+            m_numberOfLandFields++;
+        }
+    };
+}
@@ -0,0 +1,505 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: PathBenchmark.cpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#define _USE_MATH_DEFINES
+
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "../src/core/SgException.hpp"
+#include "../src/core/Log.hpp"
+#include "../src/core/Types.hpp"
+#include "../src/iso/GridSearch.hpp"
+#include "ArchipelagoGrid.hpp"
+
+//-------------------------------------------------
+// Allocation counter
+//-------------------------------------------------
+
+namespace
+{
+    std::atomic<std::size_t> numberOfAllocations{ 0 };
+
+    void* Allocate(const std::size_t t_size, const std::size_t t_alignment = alignof(std::max_align_t)) noexcept
+    {
+        numberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        if (t_alignment <= alignof(std::max_align_t))
+        {
+            return std::malloc(t_size == 0 ? 1 : t_size);
+        }
+
+        // room for the alignment and for the address to free in front of the aligned memory
+        auto* const memory{ static_cast<char*>(std::malloc(t_size + t_alignment + sizeof(void*))) };
+        if (!memory)
+        {
+            return nullptr;
+        }
+
+        const auto address{ (reinterpret_cast<std::uintptr_t>(memory + sizeof(void*)) + t_alignment - 1) & ~(t_alignment - 1) };
+        auto* const aligned{ reinterpret_cast<void**>(address) };
+        aligned[-1] = memory;
+
+        return aligned;
+    }
+
+    void Free(void* const t_memory, const std::size_t t_alignment = alignof(std::max_align_t)) noexcept
+    {
+        if (t_memory && t_alignment > alignof(std::max_align_t))
+        {
+            std::free(static_cast<void**>(t_memory)[-1]);
+            return;
+        }
+
+        std::free(t_memory);
+    }
+
+    void* AllocateOrThrow(const std::size_t t_size, const std::size_t t_alignment = alignof(std::max_align_t))
+    {
+        if (auto* const memory{ Allocate(t_size, t_alignment) })
+        {
+            return memory;
+        }
+
+        throw std::bad_alloc();
+    }
+}
+
+// all forms are replaced, so that each allocation is counted and freed by its own counterpart
+
+void* operator new(const std::size_t t_size) { return AllocateOrThrow(t_size); }
+void* operator new[](const std::size_t t_size) { return AllocateOrThrow(t_size); }
+void* operator new(const std::size_t t_size, const std::nothrow_t&) noexcept { return Allocate(t_size); }
+void* operator new[](const std::size_t t_size, const std::nothrow_t&) noexcept { return Allocate(t_size); }
+void* operator new(const std::size_t t_size, const std::align_val_t t_alignment) { return AllocateOrThrow(t_size, static_cast<std::size_t>(t_alignment)); }
+void* operator new[](const std::size_t t_size, const std::align_val_t t_alignment) { return AllocateOrThrow(t_size, static_cast<std::size_t>(t_alignment)); }
+void* operator new(const std::size_t t_size, const std::align_val_t t_alignment, const std::nothrow_t&) noexcept { return Allocate(t_size, static_cast<std::size_t>(t_alignment)); }
+void* operator new[](const std::size_t t_size, const std::align_val_t t_alignment, const std::nothrow_t&) noexcept { return Allocate(t_size, static_cast<std::size_t>(t_alignment)); }
+
+void operator delete(void* const t_memory) noexcept { Free(t_memory); }
+void operator delete[](void* const t_memory) noexcept { Free(t_memory); }
+void operator delete(void* const t_memory, std::size_t) noexcept { Free(t_memory); }
+void operator delete[](void* const t_memory, std::size_t) noexcept { Free(t_memory); }
+void operator delete(void* const t_memory, const std::nothrow_t&) noexcept { Free(t_memory); }
+void operator delete[](void* const t_memory, const std::nothrow_t&) noexcept { Free(t_memory); }
+void operator delete(void* const t_memory, const std::align_val_t t_alignment) noexcept { Free(t_memory, static_cast<std::size_t>(t_alignment)); }
+void operator delete[](void* const t_memory, const std::align_val_t t_alignment) noexcept { Free(t_memory, static_cast<std::size_t>(t_alignment)); }
+void operator delete(void* const t_memory, std::size_t, const std::align_val_t t_alignment) noexcept { Free(t_memory, static_cast<std::size_t>(t_alignment)); }
+void operator delete[](void* const t_memory, std::size_t, const std::align_val_t t_alignment) noexcept { Free(t_memory, static_cast<std::size_t>(t_alignment)); }
+void operator delete(void* const t_memory, const std::align_val_t t_alignment, const std::nothrow_t&) noexcept { Free(t_memory, static_cast<std::size_t>(t_alignment)); }
+void operator delete[](void* const t_memory, const std::align_val_t t_alignment, const std::nothrow_t&) noexcept { Free(t_memory, static_cast<std::size_t>(t_alignment)); }
+
+namespace sg::islands::bench
+{
+    using Grid = ArchipelagoGrid;
+
+    enum class Strategy
+    {
+        ASTAR,
+        ALT,
+        JPS,
+        BIDIRECTIONAL
+    };
+
+    struct Query
+    {
+        sf::Vector2i start;
+        sf::Vector2i target;
+        iso::AssetType assetType{ iso::AssetType::NONE };
+    };
+
+    using Queries = std::vector<Query>;
+
+    struct BenchmarkOptions
+    {
+        ArchipelagoOptions archipelago;
+        int numberOfQueries{ 200 };
+        int footprint{ 1 };
+        bool astar{ true };
+        bool alt{ true };
+        bool jps{ true };
+        bool bidirectional{ true };
+    };
+
+    //-------------------------------------------------
+    // Queries
+    //-------------------------------------------------
+
+    /**
+     * @brief Random water start and target positions in the same sea region.
+     */
+    Queries CreateReachableQueries(const Grid& t_grid, const int t_numberOfQueries, std::mt19937& t_random)
+    {
+        std::uniform_int_distribution<int> xDistribution{ 0, t_grid.GetMapWidth() - 1 };
+        std::uniform_int_distribution<int> yDistribution{ 0, t_grid.GetMapHeight() - 1 };
+
+        Queries queries;
+
+        for (auto attempt{ 0 }; attempt < t_numberOfQueries * 100 && static_cast<int>(queries.size()) < t_numberOfQueries; ++attempt)
+        {
+            const sf::Vector2i start{ xDistribution(t_random), yDistribution(t_random) };
+            const sf::Vector2i target{ xDistribution(t_random), yDistribution(t_random) };
+
+            if (start != target && t_grid.IsReachable(start, target, iso::AssetType::WATER_UNIT))
+            {
+                queries.push_back({ start, target, iso::AssetType::WATER_UNIT });
+            }
+        }
+
+        return queries;
+    }
+
+    /**
+     * @brief Random land start and target positions on different islands.
+     */
+    Queries CreateUnreachableQueries(const Grid& t_grid, const int t_numberOfQueries, std::mt19937& t_random)
+    {
+        std::uniform_int_distribution<int> xDistribution{ 0, t_grid.GetMapWidth() - 1 };
+        std::uniform_int_distribution<int> yDistribution{ 0, t_grid.GetMapHeight() - 1 };
+
+        Queries queries;
+
+        for (auto attempt{ 0 }; attempt < t_numberOfQueries * 1000 && static_cast<int>(queries.size()) < t_numberOfQueries; ++attempt)
+        {
+            const sf::Vector2i start{ xDistribution(t_random), yDistribution(t_random) };
+            const sf::Vector2i target{ xDistribution(t_random), yDistribution(t_random) };
+
+            const auto startIsland{ t_grid.GetIsland(start.x, start.y) };
+            const auto targetIsland{ t_grid.GetIsland(target.x, target.y) };
+
+            if (startIsland != Grid::NO_ISLAND && targetIsland != Grid::NO_ISLAND && startIsland != targetIsland)
+            {
+                queries.push_back({ start, target, iso::AssetType::LAND_UNIT });
+            }
+        }
+
+        return queries;
+    }
+
+    //-------------------------------------------------
+    // Run
+    //-------------------------------------------------
+
+    struct QueryResult
+    {
+        double microseconds{ 0.0 };
+        std::size_t expandedNodes{ 0 };
+        std::size_t allocations{ 0 };
+        bool found{ false };
+
+        /**
+         * @brief The path costs more than the A* reference, or only one of both was found.
+         */
+        bool costMismatch{ false };
+    };
+
+    /**
+     * @brief The sum of the step costs; each step to one of the eight neighbours costs one.
+     */
+    int GetPathCost(const std::vector<iso::Node>& t_path)
+    {
+        auto cost{ 0 };
+
+        for (std::size_t i{ 1 }; i < t_path.size(); ++i)
+        {
+            const auto step{ t_path[i].position - t_path[i - 1].position };
+            cost += std::max(std::abs(step.x), std::abs(step.y));
+        }
+
+        return cost;
+    }
+
+    double GetPercentile(const std::vector<double>& t_sortedValues, const double t_percentile)
+    {
+        if (t_sortedValues.empty())
+        {
+            return 0.0;
+        }
+
+        const auto index{ static_cast<std::size_t>(std::ceil(t_percentile / 100.0 * t_sortedValues.size())) };
+
+        return t_sortedValues[std::min(std::max<std::size_t>(index, 1), t_sortedValues.size()) - 1];
+    }
+
+    const char* GetName(const Strategy t_strategy)
+    {
+        switch (t_strategy)
+        {
+        case Strategy::ALT: return "alt";
+        case Strategy::JPS: return "jps";
+        case Strategy::BIDIRECTIONAL: return "bidir";
+        default: return "astar";
+        }
+    }
+
+    void Run(
+        const char* const t_name,
+        const Strategy t_strategy,
+        Grid& t_grid,
+        const Queries& t_queries,
+        const int t_footprint,
+        iso::GridSearch<Grid>& t_gridSearch
+    )
+    {
+        std::vector<QueryResult> results;
+        results.reserve(t_queries.size());
+
+        // A* with the landmark bound as heuristic
+        t_grid.SetLandmarksEnabled(t_strategy == Strategy::ALT);
+
+        std::vector<iso::Node> path;
+        std::vector<iso::Node> referencePath;
+        iso::Node startNode;
+        iso::Node endNode;
+
+        for (const auto& query : t_queries)
+        {
+            QueryResult result;
+
+            startNode.position = query.start;
+            endNode.position = query.target;
+
+            const auto allocations{ numberOfAllocations.load(std::memory_order_relaxed) };
+            const auto start{ std::chrono::steady_clock::now() };
+
+            if (t_strategy == Strategy::JPS)
+            {
+                result.found = t_gridSearch.FindJpsPath(t_grid, query.start, query.target, query.assetType, path, t_footprint);
+            }
+            else if (t_strategy == Strategy::BIDIRECTIONAL)
+            {
+                result.found = t_gridSearch.FindBidirectionalPath(t_grid, query.start, query.target, query.assetType, path, t_footprint);
+            }
+            else
+            {
+                result.found = t_gridSearch.FindPath(t_grid, startNode, endNode, query.assetType, path, t_footprint);
+            }
+
+            result.microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            result.allocations = numberOfAllocations.load(std::memory_order_relaxed) - allocations;
+            result.expandedNodes = t_gridSearch.GetExpandedNodes();
+
+            // correctness check against plain A* on the same steps; its Euclidean heuristic
+            // overestimates diagonal steps, so a shortest path may only be cheaper than the A* path
+            if (t_strategy == Strategy::BIDIRECTIONAL)
+            {
+                const auto referenceFound{ t_gridSearch.FindPath(t_grid, startNode, endNode, query.assetType, referencePath, t_footprint) };
+
+                result.costMismatch = result.found != referenceFound ||
+                    (result.found && GetPathCost(path) > GetPathCost(referencePath));
+            }
+
+            results.push_back(result);
+        }
+
+        std::vector<double> microseconds;
+        microseconds.reserve(results.size());
+
+        std::size_t found{ 0 };
+        std::size_t expandedNodes{ 0 };
+        std::size_t allocations{ 0 };
+        std::size_t costMismatches{ 0 };
+
+        for (const auto& result : results)
+        {
+            costMismatches += result.costMismatch ? 1 : 0;
+            microseconds.push_back(result.microseconds);
+            found += result.found ? 1 : 0;
+            expandedNodes += result.expandedNodes;
+            allocations += result.allocations;
+        }
+
+        std::sort(microseconds.begin(), microseconds.end());
+
+        const auto count{ std::max<std::size_t>(results.size(), 1) };
+
+        std::printf("%-24s %-6s %7zu %7zu %10.1f %10.1f %10.1f %10.1f %12.1f %8.2f\n",
+            t_name,
+            GetName(t_strategy),
+            results.size(),
+            found,
+            GetPercentile(microseconds, 50.0),
+            GetPercentile(microseconds, 90.0),
+            GetPercentile(microseconds, 99.0),
+            microseconds.empty() ? 0.0 : microseconds.back(),
+            static_cast<double>(expandedNodes) / count,
+            static_cast<double>(allocations) / count
+        );
+
+        if (costMismatches > 0)
+        {
+            std::printf("%-24s %-6s %zu path costs exceed astar\n", t_name, GetName(t_strategy), costMismatches);
+        }
+    }
+
+    //-------------------------------------------------
+    // Options
+    //-------------------------------------------------
+
+    void PrintUsage()
+    {
+        std::printf(
+            "Usage: SgIslandsBenchmark [options]\n"
+            "  --width <n>       map width in map fields (default 256)\n"
+            "  --height <n>      map height in map fields (default 256)\n"
+            "  --islands <n>     number of islands (default 12)\n"
+            "  --density <f>     part of the map covered by land, 0..1 (default 0.3)\n"
+            "  --queries <n>     queries per set (default 200)\n"
+            "  --footprint <n>   unit size in map fields (default 1)\n"
+            "  --seed <n>        random seed (default 1)\n"
+            "  --landmarks <n>   landmarks per unit type for alt (default 8)\n"
+            "  --strategy <s>    astar, alt, jps, bidir or all (default all)\n"
+        );
+    }
+
+    bool ParseOptions(const int t_argc, char** const t_argv, BenchmarkOptions& t_options)
+    {
+        for (auto i{ 1 }; i < t_argc; ++i)
+        {
+            const std::string name{ t_argv[i] };
+
+            if (name == "--help")
+            {
+                return false;
+            }
+
+            if (i + 1 >= t_argc)
+            {
+                std::fprintf(stderr, "Missing value for %s.\n", name.c_str());
+                return false;
+            }
+
+            const std::string value{ t_argv[++i] };
+
+            if (name == "--width")
+            {
+                t_options.archipelago.width = std::stoi(value);
+            }
+            else if (name == "--height")
+            {
+                t_options.archipelago.height = std::stoi(value);
+            }
+            else if (name == "--islands")
+            {
+                t_options.archipelago.numberOfIslands = std::stoi(value);
+            }
+            else if (name == "--density")
+            {
+                t_options.archipelago.density = std::stof(value);
+            }
+            else if (name == "--queries")
+            {
+                t_options.numberOfQueries = std::stoi(value);
+            }
+            else if (name == "--footprint")
+            {
+                t_options.footprint = std::max(std::stoi(value), 1);
+            }
+            else if (name == "--seed")
+            {
+                t_options.archipelago.seed = static_cast<std::uint32_t>(std::stoul(value));
+            }
+            else if (name == "--landmarks")
+            {
+                t_options.archipelago.numberOfLandmarks = std::max(std::stoi(value), 0);
+            }
+            else if (name == "--strategy")
+            {
+                t_options.astar = value == "astar" || value == "all";
+                t_options.alt = value == "alt" || value == "all";
+                t_options.jps = value == "jps" || value == "all";
+                t_options.bidirectional = value == "bidir" || value == "all";
+            }
+            else
+            {
+                std::fprintf(stderr, "Unknown option %s.\n", name.c_str());
+                return false;
+            }
+        }
+
+        return t_options.archipelago.width > 2 && t_options.archipelago.height > 2;
+    }
+}
+
+int main(const int t_argc, char** t_argv)
+{
+    using namespace sg::islands;
+
+    core::Log::Init();
+
+    // the searches report each rejected query
+    core::Log::GetCoreLogger()->set_level(spdlog::level::warn);
+
+    bench::BenchmarkOptions options;
+
+    try
+    {
+        if (!bench::ParseOptions(t_argc, t_argv, options))
+        {
+            bench::PrintUsage();
+            return 1;
+        }
+    }
+    catch (const std::exception&)
+    {
+        bench::PrintUsage();
+        return 1;
+    }
+
+    const auto generateStart{ std::chrono::steady_clock::now() };
+    bench::ArchipelagoGrid grid{ options.archipelago };
+    const auto generateMilliseconds{ std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - generateStart).count() };
+
+    std::printf("Map %dx%d, %d islands, %zu land fields (%.1f %%), seed %u, generated in %.1f ms\n\n",
+        grid.GetMapWidth(),
+        grid.GetMapHeight(),
+        options.archipelago.numberOfIslands,
+        grid.GetNumberOfLandFields(),
+        100.0 * grid.GetNumberOfLandFields() / (grid.GetMapWidth() * grid.GetMapHeight()),
+        options.archipelago.seed,
+        generateMilliseconds
+    );
+
+    std::mt19937 random{ options.archipelago.seed };
+    const auto reachable{ bench::CreateReachableQueries(grid, options.numberOfQueries, random) };
+    const auto unreachable{ bench::CreateUnreachableQueries(grid, options.numberOfQueries, random) };
+
+    iso::GridSearch<bench::Grid> gridSearch{ grid.GetMapWidth(), grid.GetMapHeight() };
+
+    std::printf("%-24s %-6s %7s %7s %10s %10s %10s %10s %12s %8s\n",
+        "set", "search", "queries", "found", "p50 us", "p90 us", "p99 us", "max us", "expanded", "allocs");
+
+    for (const auto strategy : { bench::Strategy::ASTAR, bench::Strategy::ALT, bench::Strategy::JPS, bench::Strategy::BIDIRECTIONAL })
+    {
+        if ((strategy == bench::Strategy::ASTAR && !options.astar) ||
+            (strategy == bench::Strategy::ALT && !options.alt) ||
+            (strategy == bench::Strategy::JPS && !options.jps) ||
+            (strategy == bench::Strategy::BIDIRECTIONAL && !options.bidirectional))
+        {
+            continue;
+        }
+
+        bench::Run("reachable (water)", strategy, grid, reachable, options.footprint, gridSearch);
+        bench::Run("unreachable (land)", strategy, grid, unreachable, options.footprint, gridSearch);
+    }
+
+    return 0;
+}
@@ -2,7 +2,7 @@
 // 
 // Filename: Application.hpp
 // Created:  25.01.2019
-// Updated:  16.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <future>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Window/Event.hpp>
@@ -24,6 +26,9 @@
 #include "../iso/Map.hpp"
 #include "../iso/Assets.hpp"
 #include "../iso/Astar.hpp"
+#include "../iso/PathRequestQueue.hpp"
+#include "../iso/PathSearchScheduler.hpp"
+#include "../iso/FlowFieldCache.hpp"
 #include "../ecs/Components.hpp"
 #include "../ecs/Systems.hpp"
 #include "../gui/Gui.hpp"
@@ -38,7 +43,11 @@ namespace sg::islands::core
         using MapUniquePtr = std::unique_ptr<iso::Map>;
         using AssetsUniquePtr = std::unique_ptr<iso::Assets>;
         using AstarUniquePtr = std::unique_ptr<iso::Astar>;
+        using PathRequestQueueUniquePtr = std::unique_ptr<iso::PathRequestQueue>;
+        using PathSearchSchedulerUniquePtr = std::unique_ptr<iso::PathSearchScheduler>;
+        using FlowFieldCacheUniquePtr = std::unique_ptr<iso::FlowFieldCache>;
         using BitmaskManagerUniquePtr = std::unique_ptr<BitmaskManager>;
+        using EntityGridUniquePtr = std::unique_ptr<ecs::EntityGrid>;
         using MouseUniquePtr = std::unique_ptr<Mouse>;
         using GuiUniquePtr = std::unique_ptr<gui::Gui>;
 
@@ -73,6 +82,10 @@ namespace sg::islands::core
             {
                 const auto dt{ clock.restart() };
                 timeSinceLastUpdate += dt;
+
+                // the fixed updates of this frame share one search budget
+                m_pathSearchScheduler->BeginFrame();
+
                 while (timeSinceLastUpdate > SF_TIME_PER_FRAME)
                 {
                     timeSinceLastUpdate -= SF_TIME_PER_FRAME;
@@ -134,11 +147,31 @@ namespace sg::islands::core
          */
         AstarUniquePtr m_astar;
 
+        /**
+         * @brief Solves the path requests on worker threads.
+         */
+        PathRequestQueueUniquePtr m_pathRequestQueue;
+
+        /**
+         * @brief Solves the path requests in the game thread within a budget per frame.
+         */
+        PathSearchSchedulerUniquePtr m_pathSearchScheduler;
+
+        /**
+         * @brief The flow fields for groups of units with the same target.
+         */
+        FlowFieldCacheUniquePtr m_flowFieldCache;
+
         /**
          * @brief The `BitmaskManager` for pixel perfect collision detection.
          */
         BitmaskManagerUniquePtr m_bitmaskManager;
 
+        /**
+         * @brief The entities by map position, to draw only the visible entities.
+         */
+        EntityGridUniquePtr m_entityGrid;
+
         /**
          * @brief A custom mouse cursor.
          */
@@ -166,6 +199,11 @@ namespace sg::islands::core
 
         bool m_drawMenu{ false };
 
+        /**
+         * @brief New move orders search their path with a bidirectional A* if true.
+         */
+        bool m_bidirectionalOrders{ false };
+
         // entities
         entityx::Entity m_fisherShipEntity;
         entityx::Entity m_frigateShipEntity;
@@ -208,25 +246,30 @@ namespace sg::islands::core
             m_statisticsText.setPosition(5.0f, 5.0f);
             m_statisticsText.setCharacterSize(10);
 
-            // create `TileAtlas`
-            m_tileAtlas = std::make_unique<iso::TileAtlas>(m_appOptions.backgroundTileset, m_appOptions.terrainTileset, m_appOptions.miscTileset);
-            assert(m_tileAtlas);
+            // load `TileAtlas`, `Map` and `Assets`
+            LoadScenario();
 
-            // create `Map` with all `Island`s
-            m_map = std::make_unique<iso::Map>(m_appOptions.map);
-            assert(m_map);
+            // limit the memory of the pre-rendered terrain
+            m_map->SetTerrainCacheBudget(static_cast<std::size_t>(m_appOptions.terrainCacheBudget) * 1024 * 1024);
+
+            // move the deep water only if configured
+            m_map->SetDeepWaterFlow(sf::Vector2f(static_cast<float>(m_appOptions.deepWaterFlowX), static_cast<float>(m_appOptions.deepWaterFlowY)));
 
             // create `Astar` object
             m_astar = std::make_unique<iso::Astar>(*m_map);
             assert(m_astar);
 
-            // create `BitmaskManager`
-            m_bitmaskManager = std::make_unique<BitmaskManager>();
-            assert(m_bitmaskManager);
+            // create `PathRequestQueue`
+            m_pathRequestQueue = std::make_unique<iso::PathRequestQueue>(*m_map, ThreadPool::GetDefaultNumberOfThreads());
+            assert(m_pathRequestQueue);
 
-            // create `Assets`
-            m_assets = std::make_unique<iso::Assets>(m_appOptions.assets, *m_bitmaskManager);
-            assert(m_assets);
+            // create `PathSearchScheduler`
+            m_pathSearchScheduler = std::make_unique<iso::PathSearchScheduler>(*m_map);
+            assert(m_pathSearchScheduler);
+
+            // create `FlowFieldCache`
+            m_flowFieldCache = std::make_unique<iso::FlowFieldCache>(*m_map);
+            assert(m_flowFieldCache);
 
             // create `Mouse`
             m_mouse = std::make_unique<Mouse>(*m_bitmaskManager, m_appOptions.mouseCursor);
@@ -244,6 +287,60 @@ namespace sg::islands::core
             SG_ISLANDS_INFO("[Application::Init()] Initialization finished.");
         }
 
+        /**
+         * @brief Loads the tilesets, the map with its islands and the assets at the same time.
+         *        Islands and images are decoded on a temporary thread pool; the `Map` is built
+         *        on its own thread and the textures are created here, where the GL context is.
+         */
+        void LoadScenario()
+        {
+            const auto millisecondsSince{ [](const std::chrono::steady_clock::time_point t_start)
+            {
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+            } };
+
+            const auto loadStart{ std::chrono::steady_clock::now() };
+
+            ThreadPool loadingPool{ ThreadPool::GetDefaultNumberOfThreads() };
+
+            // create `Map` with all `Island`s
+            auto mapFuture{ std::async(std::launch::async, [this, &loadingPool, millisecondsSince]()
+            {
+                const auto start{ std::chrono::steady_clock::now() };
+
+                auto map{ std::make_unique<iso::Map>(m_appOptions.map, &loadingPool) };
+                assert(map);
+
+                SG_ISLANDS_INFO("[Application::LoadScenario()] Map loaded in {:.1f} ms.", millisecondsSince(start));
+
+                return map;
+            }) };
+
+            // create `TileAtlas`
+            auto start{ std::chrono::steady_clock::now() };
+            m_tileAtlas = std::make_unique<iso::TileAtlas>(m_appOptions.backgroundTileset, m_appOptions.terrainTileset, m_appOptions.miscTileset, &loadingPool);
+            assert(m_tileAtlas);
+            SG_ISLANDS_INFO("[Application::LoadScenario()] Tile atlas loaded in {:.1f} ms.", millisecondsSince(start));
+
+            // create `BitmaskManager`
+            m_bitmaskManager = std::make_unique<BitmaskManager>();
+            assert(m_bitmaskManager);
+
+            // create `Assets`
+            start = std::chrono::steady_clock::now();
+            m_assets = std::make_unique<iso::Assets>(m_appOptions.assets, *m_bitmaskManager, &loadingPool);
+            assert(m_assets);
+            SG_ISLANDS_INFO("[Application::LoadScenario()] Assets loaded in {:.1f} ms.", millisecondsSince(start));
+
+            // wait for the `Map`
+            start = std::chrono::steady_clock::now();
+            m_map = mapFuture.get();
+            SG_ISLANDS_INFO("[Application::LoadScenario()] Waited {:.1f} ms for the map.", millisecondsSince(start));
+
+            SG_ISLANDS_INFO("[Application::LoadScenario()] Scenario loaded with {} threads in {:.1f} ms.",
+                loadingPool.GetNumberOfThreads(), millisecondsSince(loadStart));
+        }
+
         void Input()
         {
             sf::Event event{};
@@ -345,7 +442,8 @@ namespace sg::islands::core
                                 if (assetType == iso::AssetType::LAND_UNIT || assetType == iso::AssetType::WATER_UNIT)
                                 {
                                     t_target.targetMapPosition = targetMapPosition;
-                                    systems.update<ecs::FindPathSystem>(EX_TIME_PER_FRAME);
+                                    t_target.hasNewTarget = true;
+                                    t_target.bidirectional = m_bidirectionalOrders;
                                 }
                             }
                         );
@@ -360,6 +458,16 @@ namespace sg::islands::core
             const auto mouseWorldPosition{ m_window->mapPixelToCoords(mousePosition) };
             m_mouse->SetPosition(mouseWorldPosition);
 
+            // rebuild the landmark distances after the walkability has changed
+            m_map->UpdateLandmarks();
+
+            // move the water
+            m_map->UpdateDeepWater(t_dt);
+
+            // enqueue the new path requests and advance the searches of the game thread
+            systems.update<ecs::FindPathSystem>(EX_TIME_PER_FRAME);
+            systems.update<ecs::PathResultSystem>(EX_TIME_PER_FRAME);
+            systems.update<ecs::ReplanSystem>(EX_TIME_PER_FRAME);
             systems.update<ecs::AnimationSystem>(EX_TIME_PER_FRAME);
             systems.update<ecs::MovementSystem>(EX_TIME_PER_FRAME);
         }
@@ -404,6 +512,10 @@ namespace sg::islands::core
 
         void SetupEcs()
         {
+            // the grid follows the created and destroyed entities; the `MovementSystem` reports the moves
+            m_entityGrid = std::make_unique<ecs::EntityGrid>(m_map->GetMapWidth(), m_map->GetMapHeight());
+            m_entityGrid->Subscribe(events);
+
             // ships
             m_fisherShipEntity = entities.create();
             m_frigateShipEntity = entities.create();
@@ -467,11 +579,13 @@ namespace sg::islands::core
             m_bakeryEntity.assign<ecs::DirectionComponent>(iso::DEFAULT_DIRECTION);
             m_bakeryEntity.assign<ecs::RenderComponent>();
 
-            systems.add<ecs::MovementSystem>(*m_assets);
-            systems.add<ecs::RenderBuildingSystem>(*m_window, *m_assets);
-            systems.add<ecs::RenderUnitSystem>(*m_window, *m_assets, *m_tileAtlas, *m_bitmaskManager);
+            systems.add<ecs::MovementSystem>(*m_assets, *m_astar, *m_flowFieldCache, *m_entityGrid);
+            systems.add<ecs::RenderBuildingSystem>(*m_window, *m_assets, *m_entityGrid);
+            systems.add<ecs::RenderUnitSystem>(*m_window, *m_assets, *m_tileAtlas, *m_bitmaskManager, *m_entityGrid);
             systems.add<ecs::AnimationSystem>(*m_assets);
-            systems.add<ecs::FindPathSystem>(*m_assets, *m_astar);
+            systems.add<ecs::FindPathSystem>(entities, *m_assets, *m_astar, *m_pathRequestQueue, *m_pathSearchScheduler, *m_flowFieldCache);
+            systems.add<ecs::PathResultSystem>(*m_pathRequestQueue);
+            systems.add<ecs::ReplanSystem>(*m_map);
             systems.add<ecs::DebugSystem>(entities);
 
             systems.configure();
@@ -507,6 +621,63 @@ namespace sg::islands::core
                 );
             }
 
+            // pathfinding
+            auto strategy{ static_cast<int>(m_astar->GetStrategy()) };
+            ImGui::RadioButton("A*", &strategy, static_cast<int>(iso::PathStrategy::ASTAR));
+            ImGui::SameLine();
+            ImGui::RadioButton("HPA*", &strategy, static_cast<int>(iso::PathStrategy::HIERARCHICAL));
+            ImGui::SameLine();
+            ImGui::RadioButton("JPS", &strategy, static_cast<int>(iso::PathStrategy::JPS));
+            ImGui::SameLine();
+            ImGui::RadioButton("D* Lite", &strategy, static_cast<int>(iso::PathStrategy::INCREMENTAL));
+            m_astar->SetStrategy(static_cast<iso::PathStrategy>(strategy));
+
+            auto landmarks{ m_map->IsLandmarksEnabled() };
+            ImGui::Checkbox("Landmark heuristic (ALT)", &landmarks);
+            m_map->SetLandmarksEnabled(landmarks);
+
+            ImGui::Checkbox("Bidirectional A* for move orders", &m_bidirectionalOrders);
+
+            auto compareMode{ m_astar->IsCompareMode() };
+            ImGui::Checkbox("Compare A*, JPS and bidirectional A*", &compareMode);
+            m_astar->SetCompareMode(compareMode);
+
+            if (compareMode)
+            {
+                if (m_astar->HasLastQuery() && ImGui::Button("Compare last move order"))
+                {
+                    m_astar->CompareLastQuery();
+                }
+
+                const auto& comparison{ m_astar->GetLastComparison() };
+                ImGui::Text("A*:  %zu nodes, %.1f us", comparison.astar.expandedNodes, comparison.astar.microseconds);
+                ImGui::Text("JPS: %zu nodes, %.1f us", comparison.jps.expandedNodes, comparison.jps.microseconds);
+                ImGui::Text("Bi:  %zu nodes, %.1f us", comparison.bidirectional.expandedNodes, comparison.bidirectional.microseconds);
+            }
+
+            auto timeSliced{ m_pathSearchScheduler->IsEnabled() };
+            ImGui::Checkbox("Time-sliced search", &timeSliced);
+            m_pathSearchScheduler->SetEnabled(timeSliced);
+
+            if (timeSliced)
+            {
+                auto maxExpandedNodes{ static_cast<int>(m_pathSearchScheduler->GetMaxExpandedNodes()) };
+                ImGui::SliderInt("Nodes per frame", &maxExpandedNodes, 100, 50000);
+                m_pathSearchScheduler->SetMaxExpandedNodes(static_cast<std::size_t>(maxExpandedNodes));
+
+                auto maxMicroseconds{ m_pathSearchScheduler->GetMaxMicroseconds() };
+                ImGui::SliderInt("us per frame", &maxMicroseconds, 100, 8000);
+                m_pathSearchScheduler->SetMaxMicroseconds(maxMicroseconds);
+
+                ImGui::Text("Pending: %zu, last frame: %zu nodes, %.1f us",
+                    m_pathSearchScheduler->GetNumberOfPendingSearches(),
+                    m_pathSearchScheduler->GetLastExpandedNodes(),
+                    m_pathSearchScheduler->GetLastMicroseconds()
+                );
+            }
+
+            ImGui::Text("Flow fields: %zu", m_flowFieldCache->GetNumberOfGeneratedFields());
+
             // active entity
             auto fisherShip{ m_fisherShipEntity.has_component<ecs::ActiveEntityComponent>() };
             auto frigateShip{ m_frigateShipEntity.has_component<ecs::ActiveEntityComponent>() };
@@ -0,0 +1,95 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: Base64.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "SgException.hpp"
+
+namespace sg::islands::core
+{
+    class Base64
+    {
+    public:
+        /**
+         * @brief Decodes base64 text. Whitespace is skipped, so the indentation
+         *        of xml text can be passed as it is.
+         * @param t_text The null-terminated text.
+         * @return std::vector<std::uint8_t>
+         */
+        static std::vector<std::uint8_t> Decode(const char* t_text)
+        {
+            static const auto table{ CreateTable() };
+
+            std::vector<std::uint8_t> bytes;
+
+            std::uint32_t buffer{ 0 };
+            auto bits{ 0 };
+            auto padding{ 0 };
+
+            for (auto c{ t_text }; *c != '\0'; ++c)
+            {
+                if (*c == ' ' || *c == '\n' || *c == '\r' || *c == '\t')
+                {
+                    continue;
+                }
+
+                if (*c == '=')
+                {
+                    ++padding;
+                    continue;
+                }
+
+                const auto value{ table[static_cast<unsigned char>(*c)] };
+                if (value < 0 || padding > 0)
+                {
+                    THROW_SG_EXCEPTION("[Base64::Decode()] Invalid base64 text.");
+                }
+
+                buffer = buffer << 6 | static_cast<std::uint32_t>(value);
+                bits += 6;
+
+                if (bits >= 8)
+                {
+                    bits -= 8;
+                    bytes.push_back(static_cast<std::uint8_t>(buffer >> bits));
+                }
+            }
+
+            if (padding > 2 || bits >= 6)
+            {
+                THROW_SG_EXCEPTION("[Base64::Decode()] Invalid base64 text.");
+            }
+
+            return bytes;
+        }
+
+    protected:
+
+    private:
+        static std::array<std::int8_t, 256> CreateTable()
+        {
+            constexpr auto ALPHABET{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+
+            std::array<std::int8_t, 256> table{};
+            table.fill(-1);
+
+            for (auto i{ 0 }; i < 64; ++i)
+            {
+                table[static_cast<unsigned char>(ALPHABET[i])] = static_cast<std::int8_t>(i);
+            }
+
+            return table;
+        }
+    };
+}
@@ -2,7 +2,7 @@
 // 
 // Filename: BitmaskManager.hpp
 // Created:  07.03.2019
-// Updated:  09.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -101,18 +101,21 @@ namespace sg::islands::core
 
         void CreateBitmask(const sf::Texture* const t_texture, const sf::Image& t_image)
         {
+            const auto numberOfPixels{ static_cast<std::size_t>(t_texture->getSize().x) * t_texture->getSize().y };
+
             Bitmask bitmask;
-            bitmask.resize(t_texture->getSize().y * t_texture->getSize().x);
+            bitmask.resize(numberOfPixels);
 
-            for (auto y{ 0u }; y < t_texture->getSize().y; ++y)
+            // copy the alpha channel straight from the RGBA pixels of the decoded image
+            if (const auto pixels{ t_image.getPixelsPtr() })
             {
-                for (auto x{ 0u }; x < t_texture->getSize().x; ++x)
+                for (std::size_t i{ 0 }; i < numberOfPixels; ++i)
                 {
-                    bitmask[x + y * t_texture->getSize().x] = t_image.getPixel(x, y).a;
+                    bitmask[i] = pixels[i * 4 + 3];
                 }
             }
 
-            m_bitmasks.emplace(t_texture, bitmask);
+            m_bitmasks.emplace(t_texture, std::move(bitmask));
         }
 
     protected:
@@ -2,7 +2,7 @@
 // 
 // Filename: Config.hpp
 // Created:  26.01.2019
-// Updated:  09.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -44,6 +44,13 @@ namespace sg::islands::core
 
         // assets
         Filename assets;
+
+        // the memory of the pre-rendered terrain in MiB; a chunk needs about 8 to 9 MiB
+        int terrainCacheBudget{ 128 };
+
+        // the pixels the deep water moves each second; zero keeps the water still
+        int deepWaterFlowX{ 0 };
+        int deepWaterFlowY{ 0 };
     };
 
     class Config
@@ -153,6 +160,24 @@ namespace sg::islands::core
             t_options.map = map;
             t_options.assets = assets;
 
+            // the terrain cache budget is optional
+            if (worldElement->FirstChildElement("terrainCacheBudget") != nullptr)
+            {
+                t_options.terrainCacheBudget = XmlWrapper::GetIntFromXmlElement(worldElement, "terrainCacheBudget");
+            }
+
+            SG_ISLANDS_INFO("[Config::LoadAppOptions()] Terrain cache budget: {} MiB.", t_options.terrainCacheBudget);
+
+            // the deep water flow is optional
+            const auto* deepWaterFlowElement{ worldElement->FirstChildElement("deepWaterFlow") };
+            if (deepWaterFlowElement != nullptr)
+            {
+                XmlWrapper::QueryAttribute(deepWaterFlowElement, "x", &t_options.deepWaterFlowX);
+                XmlWrapper::QueryAttribute(deepWaterFlowElement, "y", &t_options.deepWaterFlowY);
+            }
+
+            SG_ISLANDS_INFO("[Config::LoadAppOptions()] Deep water flow: {}, {} pixels per second.", t_options.deepWaterFlowX, t_options.deepWaterFlowY);
+
             SG_ISLANDS_INFO("[Config::LoadAppOptions()] Options successfully loaded.");
         }
 
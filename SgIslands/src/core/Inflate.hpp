@@ -0,0 +1,422 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: Inflate.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "SgException.hpp"
+
+namespace sg::islands::core
+{
+    /**
+     * @brief A small decoder for zlib streams (RFC 1950) with deflate data (RFC 1951),
+     *        as written by Tiled for compressed layers.
+     */
+    class Inflate
+    {
+    public:
+        /**
+         * @brief Decompresses a zlib stream.
+         * @param t_data The compressed data.
+         * @param t_expectedSize The expected size of the decompressed data; used to reserve the memory.
+         * @return std::vector<std::uint8_t>
+         */
+        static std::vector<std::uint8_t> DecompressZlib(const std::vector<std::uint8_t>& t_data, const std::size_t t_expectedSize = 0)
+        {
+            if (t_data.size() < 6)
+            {
+                THROW_SG_EXCEPTION("[Inflate::DecompressZlib()] The zlib stream is truncated.");
+            }
+
+            const auto cmf{ t_data[0] };
+            const auto flg{ t_data[1] };
+
+            // compression method 8 (deflate), no preset dictionary, valid header checksum
+            if ((cmf & 0x0f) != 8 || (cmf >> 4) > 7 || (flg & 0x20) != 0 || (cmf * 256 + flg) % 31 != 0)
+            {
+                THROW_SG_EXCEPTION("[Inflate::DecompressZlib()] Invalid or unsupported zlib header.");
+            }
+
+            Decoder decoder{ t_data.data() + 2, t_data.size() - 2 };
+            decoder.output.reserve(t_expectedSize);
+            decoder.Run();
+
+            // the Adler-32 checksum follows the deflate data on the next byte boundary
+            const auto checksumPosition{ 2 + decoder.position };
+            if (checksumPosition + 4 > t_data.size())
+            {
+                THROW_SG_EXCEPTION("[Inflate::DecompressZlib()] The zlib checksum is missing.");
+            }
+
+            const auto checksum{
+                static_cast<std::uint32_t>(t_data[checksumPosition]) << 24 |
+                static_cast<std::uint32_t>(t_data[checksumPosition + 1]) << 16 |
+                static_cast<std::uint32_t>(t_data[checksumPosition + 2]) << 8 |
+                static_cast<std::uint32_t>(t_data[checksumPosition + 3])
+            };
+
+            if (checksum != Adler32(decoder.output))
+            {
+                THROW_SG_EXCEPTION("[Inflate::DecompressZlib()] The zlib checksum does not match.");
+            }
+
+            return std::move(decoder.output);
+        }
+
+    protected:
+
+    private:
+        static constexpr int MAX_BITS{ 15 };
+
+        /**
+         * @brief A canonical Huffman code: the number of codes per length and the symbols ordered by code.
+         */
+        struct Huffman
+        {
+            std::array<std::uint16_t, MAX_BITS + 1> counts;
+            std::array<std::uint16_t, 288> symbols;
+        };
+
+        struct Decoder
+        {
+            const std::uint8_t* data;
+            std::size_t size;
+
+            /**
+             * @brief The next byte to read and the bits left over from the last byte.
+             */
+            std::size_t position{ 0 };
+            std::uint32_t bitBuffer{ 0 };
+            int bitCount{ 0 };
+
+            std::vector<std::uint8_t> output;
+
+            Decoder(const std::uint8_t* t_data, const std::size_t t_size)
+                : data{ t_data }
+                , size{ t_size }
+            {}
+
+            int GetBits(const int t_count)
+            {
+                while (bitCount < t_count)
+                {
+                    if (position >= size)
+                    {
+                        THROW_SG_EXCEPTION("[Inflate::Decoder::GetBits()] The deflate data is truncated.");
+                    }
+
+                    bitBuffer |= static_cast<std::uint32_t>(data[position++]) << bitCount;
+                    bitCount += 8;
+                }
+
+                const auto value{ static_cast<int>(bitBuffer & ((1u << t_count) - 1)) };
+                bitBuffer >>= t_count;
+                bitCount -= t_count;
+
+                return value;
+            }
+
+            int DecodeSymbol(const Huffman& t_huffman)
+            {
+                auto code{ 0 };
+                auto first{ 0 };
+                auto index{ 0 };
+
+                for (auto length{ 1 }; length <= MAX_BITS; ++length)
+                {
+                    code |= GetBits(1);
+
+                    const auto count{ t_huffman.counts[length] };
+                    if (code - count < first)
+                    {
+                        return t_huffman.symbols[index + (code - first)];
+                    }
+
+                    index += count;
+                    first = (first + count) << 1;
+                    code <<= 1;
+                }
+
+                THROW_SG_EXCEPTION("[Inflate::Decoder::DecodeSymbol()] Invalid Huffman code.");
+            }
+
+            void Run()
+            {
+                auto lastBlock{ 0 };
+
+                do
+                {
+                    lastBlock = GetBits(1);
+
+                    switch (GetBits(2))
+                    {
+                    case 0: CopyStoredBlock(); break;
+                    case 1: DecodeFixedBlock(); break;
+                    case 2: DecodeDynamicBlock(); break;
+                    default: THROW_SG_EXCEPTION("[Inflate::Decoder::Run()] Invalid deflate block type.");
+                    }
+                }
+                while (!lastBlock);
+
+                // bytes are only read when needed, so the remaining bits are the padding of the last byte
+                bitBuffer = 0;
+                bitCount = 0;
+            }
+
+            void CopyStoredBlock()
+            {
+                // a stored block starts on a byte boundary
+                bitBuffer = 0;
+                bitCount = 0;
+
+                if (position + 4 > size)
+                {
+                    THROW_SG_EXCEPTION("[Inflate::Decoder::CopyStoredBlock()] The deflate data is truncated.");
+                }
+
+                const auto length{ data[position] | data[position + 1] << 8 };
+                const auto complement{ data[position + 2] | data[position + 3] << 8 };
+                position += 4;
+
+                if (length != (~complement & 0xffff) || position + length > size)
+                {
+                    THROW_SG_EXCEPTION("[Inflate::Decoder::CopyStoredBlock()] Invalid stored block.");
+                }
+
+                output.insert(output.end(), data + position, data + position + length);
+                position += length;
+            }
+
+            void DecodeFixedBlock()
+            {
+                static const auto fixedCodes{ CreateFixedCodes() };
+
+                DecodeCodes(fixedCodes.first, fixedCodes.second);
+            }
+
+            void DecodeDynamicBlock()
+            {
+                static constexpr std::array<int, 19> ORDER{ 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+                const auto numberOfLengthCodes{ GetBits(5) + 257 };
+                const auto numberOfDistanceCodes{ GetBits(5) + 1 };
+                const auto numberOfCodeLengthCodes{ GetBits(4) + 4 };
+
+                if (numberOfLengthCodes > 286 || numberOfDistanceCodes > 30)
+                {
+                    THROW_SG_EXCEPTION("[Inflate::Decoder::DecodeDynamicBlock()] Too many codes.");
+                }
+
+                std::array<std::uint8_t, 320> lengths{};
+
+                for (auto i{ 0 }; i < numberOfCodeLengthCodes; ++i)
+                {
+                    lengths[ORDER[i]] = static_cast<std::uint8_t>(GetBits(3));
+                }
+
+                Huffman codeLengthCode{};
+                BuildHuffman(codeLengthCode, lengths.data(), 19);
+
+                auto index{ 0 };
+                while (index < numberOfLengthCodes + numberOfDistanceCodes)
+                {
+                    const auto symbol{ DecodeSymbol(codeLengthCode) };
+
+                    if (symbol < 16)
+                    {
+                        lengths[index++] = static_cast<std::uint8_t>(symbol);
+                        continue;
+                    }
+
+                    std::uint8_t length{ 0 };
+                    auto repeat{ 0 };
+
+                    if (symbol == 16)
+                    {
+                        if (index == 0)
+                        {
+                            THROW_SG_EXCEPTION("[Inflate::Decoder::DecodeDynamicBlock()] No length to repeat.");
+                        }
+
+                        length = lengths[index - 1];
+                        repeat = 3 + GetBits(2);
+                    }
+                    else if (symbol == 17)
+                    {
+                        repeat = 3 + GetBits(3);
+                    }
+                    else
+                    {
+                        repeat = 11 + GetBits(7);
+                    }
+
+                    if (index + repeat > numberOfLengthCodes + numberOfDistanceCodes)
+                    {
+                        THROW_SG_EXCEPTION("[Inflate::Decoder::DecodeDynamicBlock()] Too many lengths.");
+                    }
+
+                    while (repeat-- > 0)
+                    {
+                        lengths[index++] = length;
+                    }
+                }
+
+                if (lengths[256] == 0)
+                {
+                    THROW_SG_EXCEPTION("[Inflate::Decoder::DecodeDynamicBlock()] The end of block code is missing.");
+                }
+
+                Huffman lengthCode{};
+                BuildHuffman(lengthCode, lengths.data(), numberOfLengthCodes);
+
+                Huffman distanceCode{};
+                BuildHuffman(distanceCode, lengths.data() + numberOfLengthCodes, numberOfDistanceCodes);
+
+                DecodeCodes(lengthCode, distanceCode);
+            }
+
+            void DecodeCodes(const Huffman& t_lengthCode, const Huffman& t_distanceCode)
+            {
+                static constexpr std::array<int, 29> LENGTH_BASE{
+                    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+                };
+                static constexpr std::array<int, 29> LENGTH_EXTRA{
+                    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+                };
+                static constexpr std::array<int, 30> DISTANCE_BASE{
+                    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+                };
+                static constexpr std::array<int, 30> DISTANCE_EXTRA{
+                    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+                };
+
+                for (;;)
+                {
+                    auto symbol{ DecodeSymbol(t_lengthCode) };
+
+                    if (symbol < 256)
+                    {
+                        output.push_back(static_cast<std::uint8_t>(symbol));
+                        continue;
+                    }
+
+                    if (symbol == 256)
+                    {
+                        return;
+                    }
+
+                    symbol -= 257;
+                    if (symbol >= 29)
+                    {
+                        THROW_SG_EXCEPTION("[Inflate::Decoder::DecodeCodes()] Invalid length symbol.");
+                    }
+
+                    const auto length{ LENGTH_BASE[symbol] + GetBits(LENGTH_EXTRA[symbol]) };
+
+                    const auto distanceSymbol{ DecodeSymbol(t_distanceCode) };
+                    if (distanceSymbol >= 30)
+                    {
+                        THROW_SG_EXCEPTION("[Inflate::Decoder::DecodeCodes()] Invalid distance symbol.");
+                    }
+
+                    const auto distance{ static_cast<std::size_t>(DISTANCE_BASE[distanceSymbol] + GetBits(DISTANCE_EXTRA[distanceSymbol])) };
+                    if (distance > output.size())
+                    {
+                        THROW_SG_EXCEPTION("[Inflate::Decoder::DecodeCodes()] The distance is too far back.");
+                    }
+
+                    // byte by byte, because the copy may overlap the bytes it writes
+                    auto from{ output.size() - distance };
+                    for (auto i{ 0 }; i < length; ++i)
+                    {
+                        output.push_back(output[from++]);
+                    }
+                }
+            }
+        };
+
+        static void BuildHuffman(Huffman& t_huffman, const std::uint8_t* t_lengths, const int t_numberOfSymbols)
+        {
+            t_huffman.counts.fill(0);
+
+            for (auto symbol{ 0 }; symbol < t_numberOfSymbols; ++symbol)
+            {
+                ++t_huffman.counts[t_lengths[symbol]];
+            }
+
+            t_huffman.counts[0] = 0;
+
+            // reject over-subscribed codes; incomplete codes are allowed
+            auto left{ 1 };
+            for (auto length{ 1 }; length <= MAX_BITS; ++length)
+            {
+                left = (left << 1) - t_huffman.counts[length];
+                if (left < 0)
+                {
+                    THROW_SG_EXCEPTION("[Inflate::BuildHuffman()] Over-subscribed Huffman code.");
+                }
+            }
+
+            std::array<std::uint16_t, MAX_BITS + 1> offsets{};
+            for (auto length{ 1 }; length < MAX_BITS; ++length)
+            {
+                offsets[length + 1] = static_cast<std::uint16_t>(offsets[length] + t_huffman.counts[length]);
+            }
+
+            for (auto symbol{ 0 }; symbol < t_numberOfSymbols; ++symbol)
+            {
+                if (t_lengths[symbol] != 0)
+                {
+                    t_huffman.symbols[offsets[t_lengths[symbol]]++] = static_cast<std::uint16_t>(symbol);
+                }
+            }
+        }
+
+        static std::pair<Huffman, Huffman> CreateFixedCodes()
+        {
+            std::array<std::uint8_t, 288> lengths{};
+
+            for (auto symbol{ 0 }; symbol < 288; ++symbol)
+            {
+                lengths[symbol] = symbol < 144 ? 8 : symbol < 256 ? 9 : symbol < 280 ? 7 : 8;
+            }
+
+            std::pair<Huffman, Huffman> codes{};
+            BuildHuffman(codes.first, lengths.data(), 288);
+
+            lengths.fill(5);
+            BuildHuffman(codes.second, lengths.data(), 30);
+
+            return codes;
+        }
+
+        static std::uint32_t Adler32(const std::vector<std::uint8_t>& t_data)
+        {
+            std::uint32_t a{ 1 };
+            std::uint32_t b{ 0 };
+
+            for (const auto byte : t_data)
+            {
+                a = (a + byte) % 65521;
+                b = (b + a) % 65521;
+            }
+
+            return b << 16 | a;
+        }
+    };
+}
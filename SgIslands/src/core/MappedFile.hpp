@@ -0,0 +1,174 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: MappedFile.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "SgException.hpp"
+#include "Types.hpp"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace sg::islands::core
+{
+    /**
+     * @brief A file mapped read-only into memory. The pages are loaded by the OS on first access.
+     */
+    class MappedFile
+    {
+    public:
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        MappedFile() = delete;
+
+        explicit MappedFile(const Filename& t_filename)
+        {
+            Map(t_filename);
+        }
+
+        MappedFile(const MappedFile& t_other) = delete;
+        MappedFile(MappedFile&& t_other) noexcept = delete;
+        MappedFile& operator=(const MappedFile& t_other) = delete;
+        MappedFile& operator=(MappedFile&& t_other) noexcept = delete;
+
+        ~MappedFile() noexcept
+        {
+            Unmap();
+        }
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        const std::byte* GetData() const noexcept { return m_data; }
+
+        std::size_t GetSize() const noexcept { return m_size; }
+
+    protected:
+
+    private:
+        const std::byte* m_data{ nullptr };
+        std::size_t m_size{ 0 };
+
+#ifdef _WIN32
+        HANDLE m_file{ INVALID_HANDLE_VALUE };
+        HANDLE m_mapping{ nullptr };
+#endif
+
+        //-------------------------------------------------
+        // Map && Unmap
+        //-------------------------------------------------
+
+#ifdef _WIN32
+        void Map(const Filename& t_filename)
+        {
+            m_file = CreateFileA(t_filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+            {
+                THROW_SG_EXCEPTION("[MappedFile::Map()] Error while opening file " + t_filename);
+            }
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+            {
+                Unmap();
+                THROW_SG_EXCEPTION("[MappedFile::Map()] Empty or unreadable file " + t_filename);
+            }
+
+            m_size = static_cast<std::size_t>(size.QuadPart);
+
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_mapping)
+            {
+                m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+
+            if (!m_data)
+            {
+                Unmap();
+                THROW_SG_EXCEPTION("[MappedFile::Map()] Error while mapping file " + t_filename);
+            }
+        }
+
+        void Unmap() noexcept
+        {
+            if (m_data)
+            {
+                UnmapViewOfFile(m_data);
+                m_data = nullptr;
+            }
+
+            if (m_mapping)
+            {
+                CloseHandle(m_mapping);
+                m_mapping = nullptr;
+            }
+
+            if (m_file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(m_file);
+                m_file = INVALID_HANDLE_VALUE;
+            }
+        }
+#else
+        void Map(const Filename& t_filename)
+        {
+            const auto file{ open(t_filename.c_str(), O_RDONLY) };
+            if (file < 0)
+            {
+                THROW_SG_EXCEPTION("[MappedFile::Map()] Error while opening file " + t_filename);
+            }
+
+            struct stat status{};
+            if (fstat(file, &status) != 0 || status.st_size == 0)
+            {
+                close(file);
+                THROW_SG_EXCEPTION("[MappedFile::Map()] Empty or unreadable file " + t_filename);
+            }
+
+            m_size = static_cast<std::size_t>(status.st_size);
+
+            // the mapping stays valid after the file is closed
+            auto* const data{ mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0) };
+            close(file);
+
+            if (data == MAP_FAILED)
+            {
+                THROW_SG_EXCEPTION("[MappedFile::Map()] Error while mapping file " + t_filename);
+            }
+
+            m_data = static_cast<const std::byte*>(data);
+        }
+
+        void Unmap() noexcept
+        {
+            if (m_data)
+            {
+                munmap(const_cast<std::byte*>(m_data), m_size);
+                m_data = nullptr;
+            }
+        }
+#endif
+    };
+}
@@ -0,0 +1,328 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: TextureAtlas.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include "SgException.hpp"
+
+namespace sg::islands::core
+{
+    /**
+     * @brief The place of an image in a `TextureAtlas`.
+     */
+    struct TextureRegion
+    {
+        std::size_t page{ 0 };
+        sf::IntRect rect;
+    };
+
+    /**
+     * @brief Packs many small images into a few large textures (pages), so that sprites
+     *        of the same page can be drawn without switching the texture.
+     *        The images are packed with a skyline bottom-left packer on the CPU when they are
+     *        added; `CreateTextures()` uploads the pages and must run on the thread with the GL context.
+     */
+    class TextureAtlas
+    {
+    public:
+        static constexpr unsigned DEFAULT_PAGE_SIZE{ 2048 };
+
+        /**
+         * @brief The transparent gap between two images.
+         */
+        static constexpr unsigned PADDING{ 1 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        explicit TextureAtlas(const unsigned t_pageSize = DEFAULT_PAGE_SIZE)
+            : m_pageSize{ t_pageSize }
+        {}
+
+        TextureAtlas(const TextureAtlas& t_other) = delete;
+        TextureAtlas(TextureAtlas&& t_other) noexcept = delete;
+        TextureAtlas& operator=(const TextureAtlas& t_other) = delete;
+        TextureAtlas& operator=(TextureAtlas&& t_other) noexcept = delete;
+
+        ~TextureAtlas() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        std::size_t GetNumberOfPages() const noexcept { return m_pages.size(); }
+
+        /**
+         * @brief Get the texture of a page. Valid after `CreateTextures()`; the address does not change.
+         * @param t_page The page.
+         * @return Const reference to `sf::Texture`
+         */
+        const sf::Texture& GetTexture(const std::size_t t_page) const
+        {
+            assert(t_page < m_pages.size());
+
+            return m_pages[t_page]->texture;
+        }
+
+        /**
+         * @brief Get the image of a page. Valid until `ReleaseImages()`.
+         * @param t_page The page.
+         * @return Const reference to `sf::Image`
+         */
+        const sf::Image& GetImage(const std::size_t t_page) const
+        {
+            assert(t_page < m_pages.size());
+
+            return m_pages[t_page]->image;
+        }
+
+        //-------------------------------------------------
+        // Pack
+        //-------------------------------------------------
+
+        /**
+         * @brief Copies an image into a page.
+         * @param t_image The image.
+         * @return `TextureRegion`
+         */
+        TextureRegion Add(const sf::Image& t_image)
+        {
+            const auto width{ t_image.getSize().x };
+            const auto height{ t_image.getSize().y };
+
+            // an image larger than a page gets its own page
+            if (width + PADDING > m_pageSize || height + PADDING > m_pageSize)
+            {
+                auto& page{ AddPage(width, height) };
+                page.skyline.front().y = height;
+                page.usedHeight = height;
+
+                page.image.copy(t_image, 0, 0);
+
+                return { m_pages.size() - 1, sf::IntRect(0, 0, static_cast<int>(width), static_cast<int>(height)) };
+            }
+
+            TextureRegion region;
+
+            for (std::size_t pageIndex{ 0 }; pageIndex < m_pages.size(); ++pageIndex)
+            {
+                if (Insert(*m_pages[pageIndex], pageIndex, t_image, region))
+                {
+                    return region;
+                }
+            }
+
+            AddPage(m_pageSize, m_pageSize);
+            Insert(*m_pages.back(), m_pages.size() - 1, t_image, region);
+
+            return region;
+        }
+
+        //-------------------------------------------------
+        // Upload
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates the textures of all pages; each page is cut to the height it uses.
+         */
+        void CreateTextures()
+        {
+            for (auto& page : m_pages)
+            {
+                const sf::IntRect usedArea{ 0, 0, static_cast<int>(page->width), static_cast<int>(std::max(page->usedHeight, 1u)) };
+
+                if (!page->texture.loadFromImage(page->image, usedArea))
+                {
+                    THROW_SG_EXCEPTION("[TextureAtlas::CreateTextures()] Failed to create a page texture.");
+                }
+            }
+        }
+
+        /**
+         * @brief Frees the images of the pages after the textures were created.
+         */
+        void ReleaseImages()
+        {
+            for (auto& page : m_pages)
+            {
+                page->image = sf::Image();
+            }
+        }
+
+    protected:
+
+    private:
+        /**
+         * @brief A horizontal line on which the next images can be placed.
+         */
+        struct SkylineSegment
+        {
+            unsigned x;
+            unsigned y;
+            unsigned width;
+        };
+
+        struct Page
+        {
+            unsigned width{ 0 };
+            unsigned height{ 0 };
+            unsigned usedHeight{ 0 };
+
+            sf::Image image;
+            sf::Texture texture;
+
+            std::vector<SkylineSegment> skyline;
+        };
+
+        unsigned m_pageSize{ DEFAULT_PAGE_SIZE };
+
+        /**
+         * @brief The pages; the pointers keep the textures at fixed addresses.
+         */
+        std::vector<std::unique_ptr<Page>> m_pages;
+
+        Page& AddPage(const unsigned t_width, const unsigned t_height)
+        {
+            auto page{ std::make_unique<Page>() };
+
+            page->width = t_width;
+            page->height = t_height;
+            page->image.create(t_width, t_height, sf::Color::Transparent);
+            page->skyline.push_back({ 0, 0, t_width });
+
+            m_pages.push_back(std::move(page));
+
+            return *m_pages.back();
+        }
+
+        /**
+         * @brief Places an image at the lowest position of the skyline, the leftmost of equal positions.
+         * @return bool False if the image does not fit.
+         */
+        static bool Insert(Page& t_page, const std::size_t t_pageIndex, const sf::Image& t_image, TextureRegion& t_region)
+        {
+            const auto width{ t_image.getSize().x + PADDING };
+            const auto height{ t_image.getSize().y + PADDING };
+
+            auto bestIndex{ t_page.skyline.size() };
+            auto bestY{ std::numeric_limits<unsigned>::max() };
+
+            for (std::size_t i{ 0 }; i < t_page.skyline.size(); ++i)
+            {
+                auto y{ 0u };
+                if (Fit(t_page, i, width, height, y) && y < bestY)
+                {
+                    bestIndex = i;
+                    bestY = y;
+                }
+            }
+
+            if (bestIndex == t_page.skyline.size())
+            {
+                return false;
+            }
+
+            const auto x{ t_page.skyline[bestIndex].x };
+
+            AddSkylineLevel(t_page, bestIndex, x, bestY + height, width);
+            t_page.usedHeight = std::max(t_page.usedHeight, bestY + height);
+
+            t_page.image.copy(t_image, x, bestY);
+
+            t_region.page = t_pageIndex;
+            t_region.rect = sf::IntRect(static_cast<int>(x), static_cast<int>(bestY), static_cast<int>(t_image.getSize().x), static_cast<int>(t_image.getSize().y));
+
+            return true;
+        }
+
+        /**
+         * @brief Checks if an image fits with its left edge on a skyline segment.
+         * @param t_y Gets the lowest y-position at which the image rests on the skyline.
+         */
+        static bool Fit(const Page& t_page, std::size_t t_index, const unsigned t_width, const unsigned t_height, unsigned& t_y)
+        {
+            if (t_page.skyline[t_index].x + t_width > t_page.width)
+            {
+                return false;
+            }
+
+            t_y = 0;
+            auto widthLeft{ static_cast<int>(t_width) };
+
+            while (widthLeft > 0)
+            {
+                t_y = std::max(t_y, t_page.skyline[t_index].y);
+                if (t_y + t_height > t_page.height)
+                {
+                    return false;
+                }
+
+                widthLeft -= static_cast<int>(t_page.skyline[t_index].width);
+                ++t_index;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Puts a new segment on top of the placed image and cuts the segments below it.
+         */
+        static void AddSkylineLevel(Page& t_page, const std::size_t t_index, const unsigned t_x, const unsigned t_y, const unsigned t_width)
+        {
+            auto& skyline{ t_page.skyline };
+
+            skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(t_index), { t_x, t_y, t_width });
+
+            for (auto i{ t_index + 1 }; i < skyline.size();)
+            {
+                const auto previousEnd{ skyline[i - 1].x + skyline[i - 1].width };
+                if (skyline[i].x >= previousEnd)
+                {
+                    break;
+                }
+
+                const auto shrink{ previousEnd - skyline[i].x };
+                if (skyline[i].width <= shrink)
+                {
+                    skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+                    continue;
+                }
+
+                skyline[i].x += shrink;
+                skyline[i].width -= shrink;
+                break;
+            }
+
+            // merge neighbours on the same height
+            for (std::size_t i{ 0 }; i + 1 < skyline.size();)
+            {
+                if (skyline[i].y == skyline[i + 1].y)
+                {
+                    skyline[i].width += skyline[i + 1].width;
+                    skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,175 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: ThreadPool.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sg::islands::core
+{
+    /**
+     * @brief A fixed number of worker threads that run the enqueued tasks in FIFO order.
+     *        The destructor runs the remaining tasks and joins the workers.
+     */
+    class ThreadPool
+    {
+    public:
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        ThreadPool() = delete;
+
+        /**
+         * @brief Starts the worker threads.
+         * @param t_numberOfThreads The number of workers; at least one is started.
+         */
+        explicit ThreadPool(const std::size_t t_numberOfThreads)
+        {
+            const auto numberOfThreads{ std::max<std::size_t>(t_numberOfThreads, 1) };
+
+            m_threads.reserve(numberOfThreads);
+            for (std::size_t i{ 0 }; i < numberOfThreads; ++i)
+            {
+                m_threads.emplace_back([this]() { Work(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool& t_other) = delete;
+        ThreadPool(ThreadPool&& t_other) noexcept = delete;
+        ThreadPool& operator=(const ThreadPool& t_other) = delete;
+        ThreadPool& operator=(ThreadPool&& t_other) noexcept = delete;
+
+        ~ThreadPool() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_stop = true;
+            }
+
+            m_condition.notify_all();
+
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Returns the number of worker threads.
+         * @return std::size_t
+         */
+        std::size_t GetNumberOfThreads() const noexcept { return m_threads.size(); }
+
+        /**
+         * @brief A default for the number of workers: one thread per core is left for the game thread.
+         * @return std::size_t
+         */
+        static std::size_t GetDefaultNumberOfThreads()
+        {
+            const auto cores{ std::thread::hardware_concurrency() };
+
+            return cores > 1 ? cores - 1 : 1;
+        }
+
+        //-------------------------------------------------
+        // Tasks
+        //-------------------------------------------------
+
+        /**
+         * @brief Adds a task to the queue.
+         * @tparam TTask A callable without parameters.
+         * @param t_task The task to run on a worker thread.
+         * @return std::future with the result of the task. An exception is rethrown by `get()`.
+         */
+        template <typename TTask>
+        auto Enqueue(TTask&& t_task)
+        {
+            using Result = std::invoke_result_t<std::decay_t<TTask>>;
+
+            auto task{ std::make_shared<std::packaged_task<Result()>>(std::forward<TTask>(t_task)) };
+            auto future{ task->get_future() };
+
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_tasks.emplace_back([task]() { (*task)(); });
+            }
+
+            m_condition.notify_one();
+
+            return future;
+        }
+
+        /**
+         * @brief Runs a task on a pool or, without a pool, on the thread which calls `get()` on the future.
+         * @tparam TTask A callable without parameters.
+         * @param t_threadPool The pool or nullptr.
+         * @param t_task The task to run.
+         * @return std::future with the result of the task.
+         */
+        template <typename TTask>
+        static auto EnqueueOrDefer(ThreadPool* const t_threadPool, TTask&& t_task)
+        {
+            if (t_threadPool)
+            {
+                return t_threadPool->Enqueue(std::forward<TTask>(t_task));
+            }
+
+            return std::async(std::launch::deferred, std::forward<TTask>(t_task));
+        }
+
+    protected:
+
+    private:
+        std::vector<std::thread> m_threads;
+        std::deque<std::function<void()>> m_tasks;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stop{ false };
+
+        void Work()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock<std::mutex> lock{ m_mutex };
+                    m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+                    if (m_tasks.empty())
+                    {
+                        return;
+                    }
+
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+
+                task();
+            }
+        }
+    };
+}
@@ -18,5 +18,10 @@ namespace sg::islands::core
     using TextureId = int;
     using FontId = int;
 
+    /**
+     * @brief A tile of the `TileAtlas`; also stored for each map field.
+     */
+    using TileId = int;
+
     using Filename = std::string;
 }
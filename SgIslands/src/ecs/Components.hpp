@@ -2,7 +2,7 @@
 // 
 // Filename: Components.hpp
 // Created:  21.02.2019
-// Updated:  16.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -12,8 +12,13 @@
 #pragma once
 
 #include <SFML/System/Vector2.hpp>
+#include <memory>
 #include <utility>
-#include "../iso/Node.hpp"
+#include "../iso/PathSmoother.hpp"
+#include "../iso/AbstractPath.hpp"
+#include "../iso/FlowField.hpp"
+#include "../iso/DStarLite.hpp"
+#include "../iso/PathRequestQueue.hpp"
 #include "../iso/IsoMath.hpp"
 
 namespace sg::islands::ecs
@@ -35,11 +40,43 @@ namespace sg::islands::ecs
     struct TargetComponent
     {
         sf::Vector2i targetMapPosition{ -1, -1 };
+
+        /**
+         * @brief Set with a new `targetMapPosition`; `FindPathSystem` starts the search in its next update.
+         */
+        bool hasNewTarget{ false };
+
+        /**
+         * @brief Search the path from both ends with a bidirectional A*; pays off for long moves across the map.
+         *        Only used for the searches of the `PathSearchScheduler` and the `PathRequestQueue`.
+         */
+        bool bidirectional{ false };
+
         std::size_t nextWayPoint{ 0 };
         float lengthToTarget{ -1.0f };
         bool onTheWay{ false };
         bool collision{ false };
-        std::vector<iso::Node> pathToTarget;
+        iso::Waypoints pathToTarget;
+
+        /**
+         * @brief The clusters still to pass when the path was found with `PathStrategy::HIERARCHICAL`.
+         */
+        iso::AbstractPath abstractPathToTarget;
+
+        /**
+         * @brief The pending path request; the results of older requests are ignored.
+         */
+        iso::PathRequestId pathRequestId{ iso::NO_PATH_REQUEST };
+
+        /**
+         * @brief The field shared by a group with the same target; if set, it is followed instead of `pathToTarget`.
+         */
+        std::shared_ptr<const iso::FlowField> flowField;
+
+        /**
+         * @brief Set with `PathStrategy::INCREMENTAL`; repairs `pathToTarget` when the `Map` changes.
+         */
+        std::unique_ptr<iso::DStarLite> incrementalPlanner;
     };
 
     struct AssetComponent
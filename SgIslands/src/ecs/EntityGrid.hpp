@@ -0,0 +1,217 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: EntityGrid.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <entityx/entityx.h>
+#include "Components.hpp"
+
+namespace sg::islands::ecs
+{
+    /**
+     * @brief Sorts the entities by their map position into cells of 16 x 16 map fields,
+     *        so that the entities in a map area are found without looking at all entities.
+     *        Once subscribed, the grid adds and removes the entities with their `PositionComponent`;
+     *        the owner of a `PositionComponent` must report each change of the map position.
+     */
+    class EntityGrid
+        : public entityx::Receiver<EntityGrid>
+    {
+    public:
+        static constexpr int CELL_SIZE{ 16 };
+
+        using EntityIds = std::vector<entityx::Entity::Id>;
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        EntityGrid() = delete;
+
+        /**
+         * @brief Creates an empty grid for a map of the given size.
+         * @param t_mapWidth The map width.
+         * @param t_mapHeight The map height.
+         */
+        EntityGrid(const int t_mapWidth, const int t_mapHeight)
+            : m_mapWidth{ t_mapWidth }
+            , m_mapHeight{ t_mapHeight }
+            , m_cellsX{ (t_mapWidth + CELL_SIZE - 1) / CELL_SIZE }
+            , m_cellsY{ (t_mapHeight + CELL_SIZE - 1) / CELL_SIZE }
+        {
+            m_cells.resize(static_cast<std::size_t>(m_cellsX * m_cellsY));
+        }
+
+        EntityGrid(const EntityGrid& t_other) = delete;
+        EntityGrid(EntityGrid&& t_other) noexcept = delete;
+        EntityGrid& operator=(const EntityGrid& t_other) = delete;
+        EntityGrid& operator=(EntityGrid&& t_other) noexcept = delete;
+
+        ~EntityGrid() noexcept = default;
+
+        //-------------------------------------------------
+        // Events
+        //-------------------------------------------------
+
+        /**
+         * @brief Follows the entities from now on; subscribe before the first `PositionComponent` is assigned.
+         *        A created entity has no position yet, so `EntityCreatedEvent` is not needed.
+         * @param t_eventManager The `EventManager` of the entities.
+         */
+        void Subscribe(entityx::EventManager& t_eventManager)
+        {
+            t_eventManager.subscribe<entityx::ComponentAddedEvent<PositionComponent>>(*this);
+            t_eventManager.subscribe<entityx::ComponentRemovedEvent<PositionComponent>>(*this);
+            t_eventManager.subscribe<entityx::EntityDestroyedEvent>(*this);
+        }
+
+        void receive(const entityx::ComponentAddedEvent<PositionComponent>& t_componentAdded)
+        {
+            Insert(t_componentAdded.entity.id(), t_componentAdded.component->mapPosition);
+        }
+
+        void receive(const entityx::ComponentRemovedEvent<PositionComponent>& t_componentRemoved)
+        {
+            Erase(t_componentRemoved.entity.id(), t_componentRemoved.component->mapPosition);
+        }
+
+        void receive(const entityx::EntityDestroyedEvent& t_entityDestroyed)
+        {
+            // depending on the EntityX version, the components are removed before or after this event
+            auto entity{ t_entityDestroyed.entity };
+
+            if (entity.has_component<PositionComponent>())
+            {
+                Erase(entity.id(), entity.component<PositionComponent>()->mapPosition);
+            }
+        }
+
+        //-------------------------------------------------
+        // Update
+        //-------------------------------------------------
+
+        void Insert(const entityx::Entity::Id t_entityId, const sf::Vector2i& t_mapPosition)
+        {
+            GetCell(t_mapPosition).push_back(t_entityId);
+        }
+
+        void Remove(const entityx::Entity::Id t_entityId, const sf::Vector2i& t_mapPosition)
+        {
+            [[maybe_unused]] const auto removed{ Erase(t_entityId, t_mapPosition) };
+            assert(removed);
+        }
+
+        /**
+         * @brief Moves an entity to its new map position; only a change of the cell costs something.
+         * @param t_entityId The Id of the entity.
+         * @param t_from The previous map position.
+         * @param t_to The new map position.
+         */
+        void Move(const entityx::Entity::Id t_entityId, const sf::Vector2i& t_from, const sf::Vector2i& t_to)
+        {
+            if (GetCellIndex(t_from) == GetCellIndex(t_to))
+            {
+                return;
+            }
+
+            Remove(t_entityId, t_from);
+            Insert(t_entityId, t_to);
+        }
+
+        //-------------------------------------------------
+        // Query
+        //-------------------------------------------------
+
+        /**
+         * @brief Finds the entities in the cells that touch a map area.
+         *        The result is sorted by Id, so the entities are drawn in the order of their creation.
+         * @param t_mapArea The map area; it may reach beyond the map.
+         * @param t_entityIds Gets the Ids.
+         */
+        void Query(const sf::IntRect& t_mapArea, EntityIds& t_entityIds) const
+        {
+            t_entityIds.clear();
+
+            const auto xBegin{ std::max(t_mapArea.left, 0) / CELL_SIZE };
+            const auto yBegin{ std::max(t_mapArea.top, 0) / CELL_SIZE };
+            const auto xEnd{ std::min(t_mapArea.left + t_mapArea.width, m_mapWidth) };
+            const auto yEnd{ std::min(t_mapArea.top + t_mapArea.height, m_mapHeight) };
+
+            if (xEnd <= 0 || yEnd <= 0)
+            {
+                return;
+            }
+
+            for (auto cellY{ yBegin }; cellY <= (yEnd - 1) / CELL_SIZE; ++cellY)
+            {
+                for (auto cellX{ xBegin }; cellX <= (xEnd - 1) / CELL_SIZE; ++cellX)
+                {
+                    const auto& cell{ m_cells[static_cast<std::size_t>(cellY * m_cellsX + cellX)] };
+                    t_entityIds.insert(t_entityIds.end(), cell.begin(), cell.end());
+                }
+            }
+
+            std::sort(t_entityIds.begin(), t_entityIds.end());
+        }
+
+    protected:
+
+    private:
+        int m_mapWidth{ 0 };
+        int m_mapHeight{ 0 };
+        int m_cellsX{ 0 };
+        int m_cellsY{ 0 };
+
+        std::vector<EntityIds> m_cells;
+
+        /**
+         * @brief Map positions outside the map are kept in the nearest cell.
+         */
+        std::size_t GetCellIndex(const sf::Vector2i& t_mapPosition) const
+        {
+            const auto cellX{ std::clamp(t_mapPosition.x / CELL_SIZE, 0, m_cellsX - 1) };
+            const auto cellY{ std::clamp(t_mapPosition.y / CELL_SIZE, 0, m_cellsY - 1) };
+
+            return static_cast<std::size_t>(cellY * m_cellsX + cellX);
+        }
+
+        EntityIds& GetCell(const sf::Vector2i& t_mapPosition)
+        {
+            return m_cells[GetCellIndex(t_mapPosition)];
+        }
+
+        /**
+         * @brief Removes an entity from the cell of a map position.
+         * @return bool False if the entity was not in the cell, e.g. it was already removed.
+         */
+        bool Erase(const entityx::Entity::Id t_entityId, const sf::Vector2i& t_mapPosition)
+        {
+            auto& cell{ GetCell(t_mapPosition) };
+
+            const auto it{ std::find(cell.begin(), cell.end(), t_entityId) };
+            if (it == cell.end())
+            {
+                return false;
+            }
+
+            // the order in a cell does not matter
+            *it = cell.back();
+            cell.pop_back();
+
+            return true;
+        }
+    };
+}
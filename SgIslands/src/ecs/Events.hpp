@@ -2,7 +2,7 @@
 // 
 // Filename: Events.hpp
 // Created:  12.03.2019
-// Updated:  15.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -12,6 +12,9 @@
 #pragma once
 
 #include <entityx/entityx.h>
+#include <utility>
+#include "../iso/PathSmoother.hpp"
+#include "../iso/PathRequestQueue.hpp"
 
 namespace sg::islands::ecs
 {
@@ -25,4 +28,24 @@ namespace sg::islands::ecs
         entityx::Entity::Id leftEntityId;
         entityx::Entity::Id rightEntityId;
     };
+
+    /**
+     * @brief A path request was solved by a worker thread. Emitted in the game thread.
+     */
+    struct PathFoundEvent : public entityx::Event<PathFoundEvent>
+    {
+        PathFoundEvent(const entityx::Entity::Id t_entityId, const iso::PathRequestId t_requestId, iso::Waypoints t_path)
+            : entityId{ t_entityId }
+            , requestId{ t_requestId }
+            , path{ std::move(t_path) }
+        {}
+
+        entityx::Entity::Id entityId;
+        iso::PathRequestId requestId;
+
+        /**
+         * @brief The path; empty if the target was not found.
+         */
+        iso::Waypoints path;
+    };
 }
@@ -2,7 +2,7 @@
 // 
 // Filename: Systems.hpp
 // Created:  21.02.2019
-// Updated:  16.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -13,9 +13,15 @@
 
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <entityx/System.h>
+#include <algorithm>
+#include <map>
+#include <tuple>
 #include "Components.hpp"
 #include "Events.hpp"
+#include "EntityGrid.hpp"
 #include "../iso/VecMath.hpp"
+#include "../iso/FlowFieldCache.hpp"
+#include "../iso/PathSearchScheduler.hpp"
 
 namespace sg::islands::ecs
 {
@@ -23,14 +29,35 @@ namespace sg::islands::ecs
     // FindPath
     //-------------------------------------------------
 
-    class FindPathSystem : public entityx::System<FindPathSystem>
+    class FindPathSystem : public entityx::System<FindPathSystem>, public entityx::Receiver<PathFoundEvent>
     {
     public:
-        FindPathSystem(iso::Assets& t_assets, iso::Astar& t_astar)
-            : m_assets{ t_assets }
+        /**
+         * @brief From this number of units with the same target, `AssetType` and footprint on, the units share a `FlowField`.
+         */
+        static constexpr auto MIN_FLOW_FIELD_GROUP_SIZE{ 2 };
+
+        FindPathSystem(
+            entityx::EntityManager& t_entityManager,
+            iso::Assets& t_assets,
+            iso::Astar& t_astar,
+            iso::PathRequestQueue& t_pathRequestQueue,
+            iso::PathSearchScheduler& t_pathSearchScheduler,
+            iso::FlowFieldCache& t_flowFieldCache
+        )
+            : m_entityManager{ t_entityManager }
+            , m_assets{ t_assets }
             , m_astar{ t_astar }
+            , m_pathRequestQueue{ t_pathRequestQueue }
+            , m_pathSearchScheduler{ t_pathSearchScheduler }
+            , m_flowFieldCache{ t_flowFieldCache }
         {}
 
+        void configure(entityx::EventManager& t_eventManager)
+        {
+            t_eventManager.subscribe<PathFoundEvent>(*this);
+        }
+
         void update(entityx::EntityManager& t_entities, entityx::EventManager& t_events, entityx::TimeDelta t_dt) override
         {
             entityx::ComponentHandle<AssetComponent> assetComponent;
@@ -38,38 +65,337 @@ namespace sg::islands::ecs
             entityx::ComponentHandle<TargetComponent> targetComponent;
             entityx::ComponentHandle<ActiveEntityComponent> activeEntityComponent;
 
+            // count the units per new target
+            m_groupSizes.clear();
             for (auto entity : t_entities.entities_with_components(assetComponent, positionComponent, targetComponent, activeEntityComponent))
             {
-                // get asset type
+                if (targetComponent->hasNewTarget && targetComponent->targetMapPosition.x >= 0 && targetComponent->targetMapPosition.y >= 0)
+                {
+                    const auto& asset{ m_assets.GetAsset(assetComponent->assetId) };
+                    m_groupSizes[GetGroupKey(targetComponent->targetMapPosition, asset.assetType, asset.GetFootprint())]++;
+                }
+            }
+
+            for (auto entity : t_entities.entities_with_components(assetComponent, positionComponent, targetComponent, activeEntityComponent))
+            {
+                if (!targetComponent->hasNewTarget)
+                {
+                    continue;
+                }
+
+                targetComponent->hasNewTarget = false;
+
+                // the way to the previous target is not followed anymore
+                StopMoving(*targetComponent);
+
+                // get asset type and size
                 assert(assetComponent->assetId >= 0);
-                const auto assetType{ m_assets.GetAsset(assetComponent->assetId).assetType };
+                const auto& asset{ m_assets.GetAsset(assetComponent->assetId) };
+                const auto assetType{ asset.assetType };
+                const auto footprint{ asset.GetFootprint() };
 
-                // run `FindPathToMapPosition()` if valid target position
+                // find a path if valid target position
                 if (targetComponent->targetMapPosition.x >= 0 && targetComponent->targetMapPosition.y >= 0)
                 {
-                    // find path to target
-                    const auto findNewPath{ m_astar.FindPathToMapPosition(
-                        positionComponent->mapPosition,
-                        targetComponent->targetMapPosition,
-                        assetType,
-                        targetComponent->pathToTarget
-                    ) };
-
-                    if (findNewPath)
+                    // a group shares one flow field instead of searching a path for each unit
+                    if (m_groupSizes[GetGroupKey(targetComponent->targetMapPosition, assetType, footprint)] >= MIN_FLOW_FIELD_GROUP_SIZE)
+                    {
+                        CancelRequest(entity.id(), *targetComponent);
+
+                        auto flowField{ m_flowFieldCache.Get(targetComponent->targetMapPosition, assetType, footprint) };
+                        if (flowField && flowField->HasNextPosition(positionComponent->mapPosition))
+                        {
+                            targetComponent->flowField = std::move(flowField);
+                            StartMoving(*targetComponent);
+
+                            continue;
+                        }
+
+                        // without a field the unit searches its own path below
+                    }
+
+                    if (m_astar.GetStrategy() == iso::PathStrategy::HIERARCHICAL)
                     {
-                        targetComponent->nextWayPoint = 1;
-                        targetComponent->onTheWay = true;
-                        targetComponent->collision = false;
+                        // the abstract graph is small, so the search runs in the game thread
+                        CancelRequest(entity.id(), *targetComponent);
+
+                        // find the clusters to pass and refine only the first of them
+                        const auto findNewPath{ m_astar.FindAbstractPath(
+                            positionComponent->mapPosition,
+                            targetComponent->targetMapPosition,
+                            assetType,
+                            targetComponent->abstractPathToTarget,
+                            footprint
+                        ) && m_astar.RefinePath(assetType, footprint, targetComponent->abstractPathToTarget, m_path) };
+
+                        if (findNewPath)
+                        {
+                            m_astar.SmoothPath(assetType, footprint, m_path, targetComponent->pathToTarget);
+                            StartMoving(*targetComponent);
+                        }
+
+                        continue;
+                    }
+
+                    if (m_astar.GetStrategy() == iso::PathStrategy::INCREMENTAL)
+                    {
+                        // the planner is kept, so it runs in the game thread like the repairs in `ReplanSystem`
+                        CancelRequest(entity.id(), *targetComponent);
+
+                        auto planner{ m_astar.CreateIncrementalPlanner(positionComponent->mapPosition, targetComponent->targetMapPosition, assetType, footprint) };
+                        if (planner->ComputePath(m_path))
+                        {
+                            m_astar.SmoothPath(assetType, footprint, m_path, targetComponent->pathToTarget);
+                            targetComponent->incrementalPlanner = std::move(planner);
+                            StartMoving(*targetComponent);
+                        }
+
+                        continue;
+                    }
+
+                    // the comparison runs when the debug Gui asks for it
+                    m_astar.SetLastQuery(positionComponent->mapPosition, targetComponent->targetMapPosition, assetType, footprint);
+
+                    // the unit waits with its idle animation until the path is found
+                    CancelRequest(entity.id(), *targetComponent);
+
+                    // the order may ask for a bidirectional A*
+                    auto algorithm{ m_astar.GetStrategy() == iso::PathStrategy::JPS ? iso::SearchAlgorithm::JPS : iso::SearchAlgorithm::ASTAR };
+                    if (targetComponent->bidirectional)
+                    {
+                        algorithm = iso::SearchAlgorithm::BIDIRECTIONAL;
+                    }
+
+                    // the path is applied in `receive()` when the scheduler or a worker has found it
+                    if (m_pathSearchScheduler.IsEnabled())
+                    {
+                        targetComponent->pathRequestId = m_pathSearchScheduler.Request(
+                            entity.id().id(),
+                            positionComponent->mapPosition,
+                            targetComponent->targetMapPosition,
+                            assetType,
+                            algorithm,
+                            footprint
+                        );
+                    }
+                    else
+                    {
+                        targetComponent->pathRequestId = m_pathRequestQueue.Request(
+                            entity.id().id(),
+                            positionComponent->mapPosition,
+                            targetComponent->targetMapPosition,
+                            assetType,
+                            algorithm,
+                            footprint
+                        );
                     }
                 }
             }
+
+            // advance the searches in the game thread within the budget of the frame
+            m_pathSearchScheduler.Update(m_results);
+
+            for (auto& result : m_results)
+            {
+                t_events.emit<PathFoundEvent>(entityx::Entity::Id(result.unitId), result.requestId, std::move(result.path));
+            }
+        }
+
+        void receive(const PathFoundEvent& t_pathFound)
+        {
+            // the unit was destroyed while its path was searched
+            if (!m_entityManager.valid(t_pathFound.entityId))
+            {
+                return;
+            }
+
+            auto targetComponent{ m_entityManager.component<TargetComponent>(t_pathFound.entityId) };
+
+            // the unit has no target anymore or has a newer order
+            if (!targetComponent || targetComponent->pathRequestId != t_pathFound.requestId)
+            {
+                return;
+            }
+
+            targetComponent->pathRequestId = iso::NO_PATH_REQUEST;
+
+            if (t_pathFound.path.empty())
+            {
+                return;
+            }
+
+            targetComponent->abstractPathToTarget.Clear();
+            targetComponent->flowField.reset();
+            targetComponent->incrementalPlanner.reset();
+            targetComponent->pathToTarget = t_pathFound.path;
+
+            StartMoving(*targetComponent);
         }
 
     protected:
 
     private:
+        entityx::EntityManager& m_entityManager;
         iso::Assets& m_assets;
         iso::Astar& m_astar;
+        iso::PathRequestQueue& m_pathRequestQueue;
+        iso::PathSearchScheduler& m_pathSearchScheduler;
+        iso::FlowFieldCache& m_flowFieldCache;
+
+        /**
+         * @brief The grid path before smoothing; kept to avoid allocations.
+         */
+        std::vector<iso::Node> m_path;
+
+        /**
+         * @brief The results of the scheduler; kept to avoid allocations.
+         */
+        std::vector<iso::PathResult> m_results;
+
+        using GroupKey = std::tuple<int, int, iso::AssetType, int>;
+
+        /**
+         * @brief The number of units per target, `AssetType` and footprint.
+         */
+        std::map<GroupKey, int> m_groupSizes;
+
+        static GroupKey GetGroupKey(const sf::Vector2i& t_targetMapPosition, const iso::AssetType t_assetType, const int t_footprint)
+        {
+            return { t_targetMapPosition.x, t_targetMapPosition.y, t_assetType, t_footprint };
+        }
+
+        /**
+         * @brief Makes the pending request of a unit stale, wherever it is solved.
+         */
+        void CancelRequest(const entityx::Entity::Id t_entityId, TargetComponent& t_targetComponent)
+        {
+            m_pathRequestQueue.Cancel(t_entityId.id());
+            m_pathSearchScheduler.Cancel(t_entityId.id());
+            t_targetComponent.pathRequestId = iso::NO_PATH_REQUEST;
+        }
+
+        /**
+         * @brief Forgets the way to the previous target.
+         */
+        static void StopMoving(TargetComponent& t_targetComponent)
+        {
+            t_targetComponent.pathToTarget.clear();
+            t_targetComponent.abstractPathToTarget.Clear();
+            t_targetComponent.flowField.reset();
+            t_targetComponent.incrementalPlanner.reset();
+            t_targetComponent.onTheWay = false;
+        }
+
+        static void StartMoving(TargetComponent& t_targetComponent)
+        {
+            t_targetComponent.nextWayPoint = 1;
+            t_targetComponent.onTheWay = true;
+            t_targetComponent.collision = false;
+        }
+    };
+
+    //-------------------------------------------------
+    // PathResult
+    //-------------------------------------------------
+
+    /**
+     * @brief Collects the paths found by the worker threads and emits them as `PathFoundEvent`s.
+     */
+    class PathResultSystem : public entityx::System<PathResultSystem>
+    {
+    public:
+        explicit PathResultSystem(iso::PathRequestQueue& t_pathRequestQueue)
+            : m_pathRequestQueue{ t_pathRequestQueue }
+        {}
+
+        void update(entityx::EntityManager& t_entities, entityx::EventManager& t_events, entityx::TimeDelta t_dt) override
+        {
+            m_pathRequestQueue.PollResults(m_results);
+
+            for (auto& result : m_results)
+            {
+                t_events.emit<PathFoundEvent>(entityx::Entity::Id(result.unitId), result.requestId, std::move(result.path));
+            }
+        }
+
+    protected:
+
+    private:
+        iso::PathRequestQueue& m_pathRequestQueue;
+
+        /**
+         * @brief Kept to avoid allocations.
+         */
+        std::vector<iso::PathResult> m_results;
+    };
+
+    //-------------------------------------------------
+    // Replan
+    //-------------------------------------------------
+
+    /**
+     * @brief Collects the changed map fields and lets the units with an incremental planner repair their paths.
+     */
+    class ReplanSystem : public entityx::System<ReplanSystem>
+    {
+    public:
+        explicit ReplanSystem(iso::Map& t_map)
+            : m_map{ t_map }
+        {
+            t_map.AddChangeListener([this](const int t_mapX, const int t_mapY)
+            {
+                m_changedPositions.emplace_back(t_mapX, t_mapY);
+            });
+        }
+
+        void update(entityx::EntityManager& t_entities, entityx::EventManager& t_events, entityx::TimeDelta t_dt) override
+        {
+            if (m_changedPositions.empty())
+            {
+                return;
+            }
+
+            entityx::ComponentHandle<PositionComponent> positionComponent;
+            entityx::ComponentHandle<TargetComponent> targetComponent;
+
+            for (auto entity : t_entities.entities_with_components(positionComponent, targetComponent))
+            {
+                if (!targetComponent->onTheWay || !targetComponent->incrementalPlanner)
+                {
+                    continue;
+                }
+
+                auto& planner{ *targetComponent->incrementalPlanner };
+
+                // the unit is on the way to the next waypoint; the new path starts at its current position
+                if (planner.Replan(positionComponent->mapPosition, m_changedPositions, m_path))
+                {
+                    iso::PathSmoother::Smooth(m_map, planner.GetAssetType(), planner.GetFootprint(), m_path, targetComponent->pathToTarget);
+                    targetComponent->nextWayPoint = 1;
+                }
+                else
+                {
+                    SG_ISLANDS_INFO("[ReplanSystem::update()] The path is blocked.");
+
+                    targetComponent->incrementalPlanner.reset();
+                    targetComponent->onTheWay = false;
+                }
+            }
+
+            m_changedPositions.clear();
+        }
+
+    protected:
+
+    private:
+        const iso::Map& m_map;
+
+        std::vector<sf::Vector2i> m_changedPositions;
+
+        /**
+         * @brief The grid path before smoothing; kept to avoid allocations.
+         */
+        std::vector<iso::Node> m_path;
     };
 
     //-------------------------------------------------
@@ -79,8 +405,11 @@ namespace sg::islands::ecs
     class MovementSystem : public entityx::System<MovementSystem>
     {
     public:
-        explicit MovementSystem(iso::Assets& t_assets)
+        MovementSystem(iso::Assets& t_assets, iso::Astar& t_astar, iso::FlowFieldCache& t_flowFieldCache, EntityGrid& t_entityGrid)
             : m_assets{ t_assets }
+            , m_astar{ t_astar }
+            , m_flowFieldCache{ t_flowFieldCache }
+            , m_entityGrid{ t_entityGrid }
         {}
 
         void update(entityx::EntityManager& t_entities, entityx::EventManager& t_events, entityx::TimeDelta t_dt) override
@@ -95,10 +424,32 @@ namespace sg::islands::ecs
             {
                 if (targetComponent->onTheWay)
                 {
-                    assert(targetComponent->nextWayPoint < targetComponent->pathToTarget.size());
+                    assert(assetComponent->assetId >= 0);
+                    const auto& asset{ m_assets.GetAsset(assetComponent->assetId) };
+                    const auto assetType{ asset.assetType };
 
                     // the next position ist the target
-                    auto nextTargetMapPosition{ targetComponent->pathToTarget[targetComponent->nextWayPoint].position };
+                    sf::Vector2i nextTargetMapPosition;
+
+                    if (targetComponent->flowField)
+                    {
+                        // the field may lead through map fields that have changed since
+                        targetComponent->flowField = m_flowFieldCache.Refresh(targetComponent->flowField, positionComponent->mapPosition);
+
+                        if (!targetComponent->flowField || !targetComponent->flowField->HasNextPosition(positionComponent->mapPosition))
+                        {
+                            targetComponent->flowField.reset();
+                            targetComponent->onTheWay = false;
+                            continue;
+                        }
+
+                        nextTargetMapPosition = targetComponent->flowField->GetNextPosition(positionComponent->mapPosition);
+                    }
+                    else
+                    {
+                        assert(targetComponent->nextWayPoint < targetComponent->pathToTarget.size());
+                        nextTargetMapPosition = targetComponent->pathToTarget[targetComponent->nextWayPoint];
+                    }
 
                     // calc target screen position
                     auto targetScreenPosition{ iso::IsoMath::ToScreen(nextTargetMapPosition, true) };
@@ -114,28 +465,56 @@ namespace sg::islands::ecs
                     iso::VecMath::Normalize(directionComponent->spriteScreenNormalDirection);
 
                     // only if it is a moving object: change the direction of the sprite in the direction of movement
-                    assert(assetComponent->assetId >= 0);
-                    const auto assetType{ m_assets.GetAsset(assetComponent->assetId).assetType };
                     if (assetType != iso::AssetType::BUILDING)
                     {
                         directionComponent->direction = iso::Assets::GetUnitDirectionByVec(directionComponent->spriteScreenNormalDirection);
                     }
 
+                    const auto previousMapPosition{ positionComponent->mapPosition };
+
                     if (targetComponent->lengthToTarget > 1.0f)
                     {
                         positionComponent->screenPosition.x += directionComponent->spriteScreenNormalDirection.x;
                         positionComponent->screenPosition.y += directionComponent->spriteScreenNormalDirection.y;
+
+                        // a waypoint can be many map fields away; the flow field needs the exact map field
+                        if (!targetComponent->flowField)
+                        {
+                            positionComponent->mapPosition = iso::IsoMath::ToNearestMap(positionComponent->screenPosition);
+                        }
                     }
 
                     if (targetComponent->lengthToTarget <= 1.0f)
                     {
-                        positionComponent->mapPosition = targetComponent->targetMapPosition;
+                        positionComponent->mapPosition = nextTargetMapPosition;
                         targetComponent->nextWayPoint++;
                     }
 
-                    if (targetComponent->nextWayPoint == targetComponent->pathToTarget.size())
+                    m_entityGrid.Move(entity.id(), previousMapPosition, positionComponent->mapPosition);
+
+                    if (targetComponent->flowField)
+                    {
+                        if (positionComponent->mapPosition == targetComponent->flowField->GetTargetPosition())
+                        {
+                            targetComponent->flowField.reset();
+                            targetComponent->onTheWay = false;
+                        }
+                    }
+                    else if (targetComponent->nextWayPoint == targetComponent->pathToTarget.size())
                     {
-                        targetComponent->onTheWay = false;
+                        // refine the next clusters of a hierarchical path
+                        if (!targetComponent->abstractPathToTarget.IsComplete() &&
+                            m_astar.RefinePath(assetType, asset.GetFootprint(), targetComponent->abstractPathToTarget, m_path))
+                        {
+                            m_astar.SmoothPath(assetType, asset.GetFootprint(), m_path, targetComponent->pathToTarget);
+                            targetComponent->nextWayPoint = 1;
+                        }
+                        else
+                        {
+                            targetComponent->abstractPathToTarget.Clear();
+                            targetComponent->incrementalPlanner.reset();
+                            targetComponent->onTheWay = false;
+                        }
                     }
                 }
             }
@@ -145,6 +524,14 @@ namespace sg::islands::ecs
 
     private:
         iso::Assets& m_assets;
+        iso::Astar& m_astar;
+        iso::FlowFieldCache& m_flowFieldCache;
+        EntityGrid& m_entityGrid;
+
+        /**
+         * @brief The grid path before smoothing; kept to avoid allocations.
+         */
+        std::vector<iso::Node> m_path;
     };
 
     //-------------------------------------------------
@@ -210,24 +597,41 @@ namespace sg::islands::ecs
     class RenderBuildingSystem : public entityx::System<RenderBuildingSystem>
     {
     public:
+        /**
+         * @brief The map fields around the view in which buildings are looked for; a building is larger than its map position.
+         */
+        static constexpr auto VIEW_MARGIN{ 8 };
+
         RenderBuildingSystem(
             sf::RenderWindow& t_window,
-            iso::Assets& t_assets
+            iso::Assets& t_assets,
+            EntityGrid& t_entityGrid
         )
             : m_window{ t_window }
             , m_assets{ t_assets }
+            , m_entityGrid{ t_entityGrid }
         {}
 
         void update(entityx::EntityManager& t_entities, entityx::EventManager& t_events, entityx::TimeDelta t_dt) override
         {
-            entityx::ComponentHandle<PositionComponent> positionComponent;
-            entityx::ComponentHandle<BuildingComponent> buildingComponent;
-            entityx::ComponentHandle<AssetComponent> assetComponent;
-            entityx::ComponentHandle<DirectionComponent> directionComponent;
-            entityx::ComponentHandle<RenderComponent> renderComponent;
+            // only the buildings that can be seen
+            m_entityGrid.Query(iso::IsoMath::ToMapArea(m_window.getView(), VIEW_MARGIN), m_entityIds);
 
-            for (auto entity : t_entities.entities_with_components(positionComponent, buildingComponent, assetComponent, directionComponent, renderComponent))
+            for (const auto entityId : m_entityIds)
             {
+                auto entity{ t_entities.get(entityId) };
+
+                auto positionComponent{ entity.component<PositionComponent>() };
+                auto buildingComponent{ entity.component<BuildingComponent>() };
+                auto assetComponent{ entity.component<AssetComponent>() };
+                auto directionComponent{ entity.component<DirectionComponent>() };
+                auto renderComponent{ entity.component<RenderComponent>() };
+
+                if (!positionComponent || !buildingComponent || !assetComponent || !directionComponent || !renderComponent)
+                {
+                    continue;
+                }
+
                 assert(assetComponent->assetId >= 0);
                 const auto& asset{ m_assets.GetAsset(assetComponent->assetId) };
                 const auto assetType{ asset.assetType };
@@ -267,21 +671,34 @@ namespace sg::islands::ecs
     private:
         sf::RenderWindow& m_window;
         iso::Assets& m_assets;
+        EntityGrid& m_entityGrid;
+
+        /**
+         * @brief The result of the last query; kept to avoid allocations.
+         */
+        EntityGrid::EntityIds m_entityIds;
     };
 
     class RenderUnitSystem : public entityx::System<RenderUnitSystem>
     {
     public:
+        /**
+         * @brief The map fields around the view in which units are looked for; a ship is larger than its map position.
+         */
+        static constexpr auto VIEW_MARGIN{ 8 };
+
         RenderUnitSystem(
             sf::RenderWindow& t_window,
             iso::Assets& t_assets,
             iso::TileAtlas& t_tileAtlas,
-            core::BitmaskManager& t_bitmaskManager
+            core::BitmaskManager& t_bitmaskManager,
+            EntityGrid& t_entityGrid
         )
             : m_window{ t_window }
             , m_assets{ t_assets }
             , m_tileAtlas{ t_tileAtlas }
             , m_bitmaskManager{ t_bitmaskManager }
+            , m_entityGrid{ t_entityGrid }
         {}
 
         void update(entityx::EntityManager& t_entities, entityx::EventManager& t_events, entityx::TimeDelta t_dt) override
@@ -289,14 +706,32 @@ namespace sg::islands::ecs
             sf::Sprite* sprite;
             iso::Animation* animation;
 
-            entityx::ComponentHandle<PositionComponent> positionComponent;
-            entityx::ComponentHandle<AssetComponent> assetComponent;
-            entityx::ComponentHandle<DirectionComponent> directionComponent;
-            entityx::ComponentHandle<TargetComponent> targetComponent;
-            entityx::ComponentHandle<RenderComponent> renderComponent;
+            // the units that can be seen and the active units, which check for collisions anywhere
+            m_entityGrid.Query(iso::IsoMath::ToMapArea(m_window.getView(), VIEW_MARGIN), m_entityIds);
+
+            t_entities.each<ActiveEntityComponent>([this](entityx::Entity t_entity, ActiveEntityComponent&)
+            {
+                m_entityIds.push_back(t_entity.id());
+            });
+
+            std::sort(m_entityIds.begin(), m_entityIds.end());
+            m_entityIds.erase(std::unique(m_entityIds.begin(), m_entityIds.end()), m_entityIds.end());
 
-            for (auto entity : t_entities.entities_with_components(positionComponent, assetComponent, directionComponent, targetComponent, renderComponent))
+            for (const auto entityId : m_entityIds)
             {
+                auto entity{ t_entities.get(entityId) };
+
+                auto positionComponent{ entity.component<PositionComponent>() };
+                auto assetComponent{ entity.component<AssetComponent>() };
+                auto directionComponent{ entity.component<DirectionComponent>() };
+                auto targetComponent{ entity.component<TargetComponent>() };
+                auto renderComponent{ entity.component<RenderComponent>() };
+
+                if (!positionComponent || !assetComponent || !directionComponent || !targetComponent || !renderComponent)
+                {
+                    continue;
+                }
+
                 assert(assetComponent->assetId >= 0);
                 const auto& asset{ m_assets.GetAsset(assetComponent->assetId) };
                 const auto assetType{ asset.assetType };
@@ -345,7 +780,6 @@ namespace sg::islands::ecs
                                 // clear target
                                 targetComponent->collision = true;
                                 targetComponent->onTheWay = false;
-                                positionComponent->mapPosition = targetComponent->pathToTarget[targetComponent->nextWayPoint - 1].position;
                                 targetComponent->pathToTarget.clear();
                                 targetComponent->lengthToTarget = -1.0f;
                                 targetComponent->nextWayPoint = 1;
@@ -385,7 +819,6 @@ namespace sg::islands::ecs
                                 // clear target
                                 targetComponent->collision = true;
                                 targetComponent->onTheWay = false;
-                                positionComponent->mapPosition = targetComponent->pathToTarget[targetComponent->nextWayPoint - 1].position;
                                 targetComponent->pathToTarget.clear();
                                 targetComponent->lengthToTarget = -1.0f;
                                 targetComponent->nextWayPoint = 1;
@@ -425,7 +858,6 @@ namespace sg::islands::ecs
                                 // clear target
                                 targetComponent->collision = true;
                                 targetComponent->onTheWay = false;
-                                positionComponent->mapPosition = targetComponent->pathToTarget[targetComponent->nextWayPoint - 1].position;
                                 targetComponent->pathToTarget.clear();
                                 targetComponent->lengthToTarget = -1.0f;
                                 targetComponent->nextWayPoint = 1;
@@ -441,9 +873,9 @@ namespace sg::islands::ecs
                 {
                     m_tileAtlas.DrawMiscTile(iso::TileAtlas::BUOY_TILE, targetComponent->targetMapPosition.x, targetComponent->targetMapPosition.y, m_window);
 
-                    for (const auto& node : targetComponent->pathToTarget)
+                    for (const auto& wayPoint : targetComponent->pathToTarget)
                     {
-                        m_tileAtlas.DrawMiscTile(iso::TileAtlas::GRID_TILE, node.position.x, node.position.y, m_window);
+                        m_tileAtlas.DrawMiscTile(iso::TileAtlas::GRID_TILE, wayPoint.x, wayPoint.y, m_window);
                     }
                 }
 
@@ -462,6 +894,12 @@ namespace sg::islands::ecs
         iso::Assets& m_assets;
         iso::TileAtlas& m_tileAtlas;
         core::BitmaskManager& m_bitmaskManager;
+        EntityGrid& m_entityGrid;
+
+        /**
+         * @brief The entities to draw in this frame; kept to avoid allocations.
+         */
+        EntityGrid::EntityIds m_entityIds;
     };
 
     //-------------------------------------------------
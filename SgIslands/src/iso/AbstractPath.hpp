@@ -0,0 +1,50 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: AbstractPath.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief The result of a hierarchical search: the cluster entrances from the start to the target.
+     *        The map positions between two entrances are only computed when the unit gets there.
+     */
+    struct AbstractPath
+    {
+        /**
+         * @brief The start, the entrances and the target.
+         */
+        std::vector<sf::Vector2i> positions;
+
+        /**
+         * @brief The index of the first position that has not been refined yet.
+         */
+        std::size_t next{ 0 };
+
+        /**
+         * @brief Checks if there is nothing left to refine.
+         * @return bool
+         */
+        bool IsComplete() const noexcept
+        {
+            return positions.empty() || next + 1 >= positions.size();
+        }
+
+        void Clear()
+        {
+            positions.clear();
+            next = 0;
+        }
+    };
+}
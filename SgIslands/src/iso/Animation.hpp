@@ -2,7 +2,7 @@
 // 
 // Filename: Animation.hpp
 // Created:  26.01.2019
-// Updated:  25.02.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -11,9 +11,9 @@
 
 #pragma once
 
-#include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/System/Time.hpp>
+#include "../core/TextureAtlas.hpp"
 
 namespace sg::islands::iso
 {
@@ -22,14 +22,22 @@ namespace sg::islands::iso
     public:
         static constexpr auto FRAME_TIME{ 0.2f };
 
-        using Frame = sf::Texture;
+        using Frame = core::TextureRegion;
         using Frames = std::vector<Frame>;
 
         //-------------------------------------------------
         // Ctor. && Dtor.
         //-------------------------------------------------
 
-        Animation() = default;
+        Animation() = delete;
+
+        /**
+         * @brief Creates an `Animation` whose frames are regions of the given atlas.
+         * @param t_textureAtlas The atlas with the frame images.
+         */
+        explicit Animation(const core::TextureAtlas& t_textureAtlas)
+            : m_textureAtlas{ t_textureAtlas }
+        {}
 
         Animation(const Animation& t_other) = delete;
         Animation(Animation&& t_other) noexcept = delete;
@@ -84,7 +92,7 @@ namespace sg::islands::iso
         {
             assert(t_frameNumber < m_frames.size());
 
-            m_sprite.setTexture(m_frames[t_frameNumber]);
+            SetSpriteFrame(m_frames[t_frameNumber]);
         }
 
         //-------------------------------------------------
@@ -92,22 +100,12 @@ namespace sg::islands::iso
         //-------------------------------------------------
 
         /**
-         * @brief Add a texture as frame.
-         * @param t_filename The file path.
+         * @brief Add a frame.
+         * @param t_frame The region of the frame image in the atlas.
          */
-        void AddFrame(const core::Filename& t_filename)
+        void AddFrame(const Frame& t_frame)
         {
-            Frame frame;
-
-            // load frame texture
-            const auto result{ frame.loadFromFile(t_filename) };
-            if (!result)
-            {
-                THROW_SG_EXCEPTION("[Animation::AddFrame()] Failed to load texture " + t_filename);
-            }
-
-            // save frame
-            m_frames.push_back(frame);
+            m_frames.push_back(t_frame);
         }
 
         //-------------------------------------------------
@@ -141,13 +139,15 @@ namespace sg::islands::iso
                 }
 
                 // set the current frame
-                m_sprite.setTexture(m_frames[m_currentFrame]);
+                SetSpriteFrame(m_frames[m_currentFrame]);
             }
         }
 
     protected:
 
     private:
+        const core::TextureAtlas& m_textureAtlas;
+
         sf::Time m_frameTime{ sf::seconds(FRAME_TIME) };
 
         Frames m_frames;
@@ -155,5 +155,15 @@ namespace sg::islands::iso
 
         std::size_t m_currentFrame{ 0 };
         sf::Time m_currentTime{ sf::Time::Zero };
+
+        /**
+         * @brief Shows a frame; frames on the same atlas page only change the texture rect.
+         * @param t_frame The frame.
+         */
+        void SetSpriteFrame(const Frame& t_frame)
+        {
+            m_sprite.setTexture(m_textureAtlas.GetTexture(t_frame.page));
+            m_sprite.setTextureRect(t_frame.rect);
+        }
     };
 }
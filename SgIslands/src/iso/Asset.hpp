@@ -2,7 +2,7 @@
 // 
 // Filename: Asset.hpp
 // Created:  15.02.2019
-// Updated:  25.02.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include "AssetAnimation.hpp"
+#include "ClearanceMap.hpp"
 
 namespace sg::islands::iso
 {
@@ -35,6 +37,13 @@ namespace sg::islands::iso
         int tileWidth{ -1 };
         int tileHeight{ -1 };
 
+        /**
+         * @brief Get the width and height in map fields that a unit needs to pass.
+         *        Limited to the largest square the `ClearanceMap` knows.
+         * @return int
+         */
+        int GetFootprint() const { return std::clamp(std::max(tileWidth, tileHeight), 1, static_cast<int>(ClearanceMap::MAX_CLEARANCE)); }
+
         /**
          * @brief An `Asset` can contain multiple `AssetAnimationUniquePtr`.
          *        The key is an `AnimationName`, such `Work`, `Move` or `Idle`.
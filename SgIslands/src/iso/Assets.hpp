@@ -2,7 +2,7 @@
 // 
 // Filename: Assets.hpp
 // Created:  14.02.2019
-// Updated:  09.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -11,12 +11,15 @@
 
 #pragma once
 
+#include <future>
 #include <vector>
 #include "Asset.hpp"
 #include "Animation.hpp"
 #include "../core/Types.hpp"
 #include "../core/XmlWrapper.hpp"
 #include "../core/Log.hpp"
+#include "../core/ThreadPool.hpp"
+#include "../core/TextureAtlas.hpp"
 
 namespace sg::islands::iso
 {
@@ -33,10 +36,17 @@ namespace sg::islands::iso
 
         Assets() = delete;
 
-        explicit Assets(const core::Filename& t_filename, core::BitmaskManager& t_bitmaskManager)
+        /**
+         * @brief Loads all assets.
+         * @param t_filename The xml file with asset configurations.
+         * @param t_bitmaskManager Creates the bitmasks of the Idle frames.
+         * @param t_threadPool Decodes the frame images of all assets at once; the textures are
+         *                     always created on the calling thread, which owns the GL context.
+         */
+        Assets(const core::Filename& t_filename, core::BitmaskManager& t_bitmaskManager, core::ThreadPool* const t_threadPool = nullptr)
             : m_bitmaskManager{ t_bitmaskManager }
         {
-            LoadConfigFile(t_filename);
+            LoadConfigFile(t_filename, t_threadPool);
         }
 
         Assets(const Assets& t_other) = delete;
@@ -237,6 +247,11 @@ namespace sg::islands::iso
          */
         core::BitmaskManager& m_bitmaskManager;
 
+        /**
+         * @brief The frame images of all animations; declared before the assets, which refer to it.
+         */
+        core::TextureAtlas m_textureAtlas;
+
         /**
          * @brief Container for all assets. The id of the asset is the index.
          */
@@ -247,6 +262,17 @@ namespace sg::islands::iso
          */
         AssetsIdMap m_assetsIdMap;
 
+        /**
+         * @brief A frame image, decoded on a worker thread, and the `Animation` it belongs to.
+         */
+        struct FrameImage
+        {
+            Animation* animation;
+            std::future<sf::Image> image;
+        };
+
+        using FrameImages = std::vector<FrameImage>;
+
         //-------------------------------------------------
         // Load Data
         //-------------------------------------------------
@@ -304,6 +330,11 @@ namespace sg::islands::iso
             assetUniquePtr->tileWidth = tileWidthAttr;
             assetUniquePtr->tileHeight = tileHeightAttr;
 
+            if (assetType != AssetType::BUILDING && std::max(tileWidthAttr, tileHeightAttr) > ClearanceMap::MAX_CLEARANCE)
+            {
+                SG_ISLANDS_WARN("[Assets::CreateAssetFromXml()] The unit {} is searched with a footprint of {} map fields.", nameAttr, static_cast<int>(ClearanceMap::MAX_CLEARANCE));
+            }
+
             // push back to a vector for access via Id
             m_assetsMap.push_back(std::move(assetUniquePtr));
 
@@ -319,12 +350,16 @@ namespace sg::islands::iso
          * @param t_element Xml element from which to read.
          * @param t_dir The base directory from the `<dir>` element.
          * @param t_directions An array with all directions.
+         * @param t_threadPool The pool to decode the frame images or nullptr.
+         * @param t_frameImages Gets the frame images to create the textures from.
          */
         template <std::size_t Size>
         void LoadAssetsFromElement(
             const tinyxml2::XMLElement* const t_element,
             const std::string& t_dir,
-            const std::array<Direction, Size>& t_directions
+            const std::array<Direction, Size>& t_directions,
+            core::ThreadPool* const t_threadPool,
+            FrameImages& t_frameImages
         )
         {
             SG_ISLANDS_INFO("[Assets::LoadAssetsFromElement()] Loading assets from {} ...", t_dir);
@@ -364,15 +399,13 @@ namespace sg::islands::iso
                     // create an `Animation` for each direction
                     for (const auto& direction : t_directions)
                     {
-                        sf::Image image;
-
                         // create animation dir
                         const auto dir{ t_dir + dirAttr };
 
                         // create a new `Animation` for this direction
-                        auto animationUniquePtr{ std::make_unique<Animation>() };
+                        auto animationUniquePtr{ std::make_unique<Animation>(m_textureAtlas) };
 
-                        // create all frames for this `Animation`
+                        // decode all frames for this `Animation`
                         for (auto i{ 0 }; i < framesAttr; ++i)
                         {
                             // create filename with four leading zeros
@@ -380,22 +413,18 @@ namespace sg::islands::iso
                             const auto filename{ std::string(4 - str.length(), '0') + str + ".png" };
 
                             const auto directionDir{ std::to_string(static_cast<int>(direction)) };
+                            const auto path{ dir + directionDir + "/" + filename };
 
-                            // add frame
-                            animationUniquePtr->AddFrame(dir + directionDir + "/" + filename);
-
-                            // add `Bitmask`
-                            if (nameAttr == "Idle")
+                            t_frameImages.push_back({ animationUniquePtr.get(), core::ThreadPool::EnqueueOrDefer(t_threadPool, [path]()
                             {
-                                // load image
-                                image.loadFromFile(dir + directionDir + "/" + filename);
-
-                                // get texture
-                                const auto& texture{ animationUniquePtr->GetFrames()[0] };
-
-                                // create bitmask
-                                m_bitmaskManager.CreateBitmask(&texture, image);
-                            }
+                                sf::Image image;
+                                if (!image.loadFromFile(path))
+                                {
+                                    THROW_SG_EXCEPTION("[Assets::LoadAssetsFromElement()] Failed to load image " + path);
+                                }
+
+                                return image;
+                            }) });
                         }
 
                         // add `Animation` to `AssetAnimation`
@@ -407,14 +436,42 @@ namespace sg::islands::iso
                 }
             }
 
-            SG_ISLANDS_INFO("[Assets::LoadAssetsFromElement()] Successfully loaded assets.");
+            SG_ISLANDS_INFO("[Assets::LoadAssetsFromElement()] Successfully read assets.");
+        }
+
+        /**
+         * @brief Packs the decoded frame images into the atlas in the order they were read,
+         *        then creates the page textures and a bitmask for each page.
+         *        Each image is decoded once and released after it is packed.
+         * @param t_frameImages The frame images.
+         */
+        void CreateFrames(FrameImages& t_frameImages)
+        {
+            for (auto& frameImage : t_frameImages)
+            {
+                // add frame
+                frameImage.animation->AddFrame(m_textureAtlas.Add(frameImage.image.get()));
+            }
+
+            m_textureAtlas.CreateTextures();
+
+            // the sprites use the page textures, so the collision uses the bitmasks of the pages
+            for (std::size_t page{ 0 }; page < m_textureAtlas.GetNumberOfPages(); ++page)
+            {
+                m_bitmaskManager.CreateBitmask(&m_textureAtlas.GetTexture(page), m_textureAtlas.GetImage(page));
+            }
+
+            m_textureAtlas.ReleaseImages();
+
+            SG_ISLANDS_INFO("[Assets::CreateFrames()] Packed {} frames into {} atlas pages.", t_frameImages.size(), m_textureAtlas.GetNumberOfPages());
         }
 
         /**
          * @brief Load all assets from a given config file.
          * @param t_filename The xml file with asset configurations.
+         * @param t_threadPool The pool to decode the frame images or nullptr.
          */
-        void LoadConfigFile(const core::Filename& t_filename)
+        void LoadConfigFile(const core::Filename& t_filename, core::ThreadPool* const t_threadPool)
         {
             SG_ISLANDS_INFO("[Assets::LoadConfigFile()] Open {} for reading assets.", t_filename);
 
@@ -426,6 +483,9 @@ namespace sg::islands::iso
             // get `<assets>` element
             const auto assetsElement{ core::XmlWrapper::GetFirstChildElement(document, "assets") };
 
+            // the images of units and buildings are decoded at the same time
+            FrameImages frameImages;
+
             // read units ...
 
             // get `<units>` element
@@ -434,7 +494,7 @@ namespace sg::islands::iso
             // get the units base directory from the `<dir>` element
             const auto unitsDir{ core::XmlWrapper::GetStringFromXmlElement(unitsElement, "dir") };
 
-            LoadAssetsFromElement<NUMBER_OF_UNIT_DIRECTIONS>(unitsElement, unitsDir, UNIT_DIRECTIONS);
+            LoadAssetsFromElement<NUMBER_OF_UNIT_DIRECTIONS>(unitsElement, unitsDir, UNIT_DIRECTIONS, t_threadPool, frameImages);
 
             // read buildings ...
 
@@ -444,7 +504,9 @@ namespace sg::islands::iso
             // get the buildings base directory from the `<dir>` element
             const auto buildingsDir{ core::XmlWrapper::GetStringFromXmlElement(buildingsElement, "dir") };
 
-            LoadAssetsFromElement<NUMBER_OF_BUILDING_DIRECTIONS>(buildingsElement, buildingsDir, BUILDING_DIRECTIONS);
+            LoadAssetsFromElement<NUMBER_OF_BUILDING_DIRECTIONS>(buildingsElement, buildingsDir, BUILDING_DIRECTIONS, t_threadPool, frameImages);
+
+            CreateFrames(frameImages);
 
             SG_ISLANDS_INFO("[Assets::LoadConfigFile()] Loaded {} assets.", m_assetsMap.size());
         }
@@ -2,7 +2,7 @@
 // 
 // Filename: Astar.hpp
 // Created:  02.02.2019
-// Updated:  22.02.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -12,16 +12,68 @@
 #pragma once
 
 #include <vector>
-#include <stack>
+#include <chrono>
+#include <climits>
+#include <map>
+#include <memory>
 #include "Node.hpp"
-#include "IsoMath.hpp"
+#include "GridSearch.hpp"
 #include "Map.hpp"
+#include "ClusterGraph.hpp"
+#include "DStarLite.hpp"
+#include "PathSmoother.hpp"
 
 namespace sg::islands::iso
 {
+    enum class PathStrategy
+    {
+        ASTAR,
+        HIERARCHICAL,
+        JPS,
+        INCREMENTAL
+    };
+
+    /**
+     * @brief Measurements of one search.
+     */
+    struct PathStatistics
+    {
+        std::size_t expandedNodes{ 0 };
+        std::size_t pathLength{ 0 };
+        double microseconds{ 0.0 };
+    };
+
+    /**
+     * @brief A*, Jump Point Search and bidirectional A* on the same query.
+     */
+    struct PathComparison
+    {
+        PathStatistics astar;
+        PathStatistics jps;
+        PathStatistics bidirectional;
+    };
+
+    /**
+     * @brief A search to compare on request of the debug Gui.
+     */
+    struct PathQuery
+    {
+        sf::Vector2i startPosition{ -1, -1 };
+        sf::Vector2i targetPosition{ -1, -1 };
+        AssetType assetType{ AssetType::WATER_UNIT };
+        int footprint{ 1 };
+    };
+
     class Astar
     {
     public:
+        using DStarLiteUniquePtr = std::unique_ptr<DStarLite>;
+
+        /**
+         * @brief The number of clusters a hierarchical path is refined ahead.
+         */
+        static constexpr auto REFINE_CLUSTERS{ 3 };
+
         //-------------------------------------------------
         // Ctor. && Dtor.
         //-------------------------------------------------
@@ -30,9 +82,11 @@ namespace sg::islands::iso
 
         explicit Astar(Map& t_map)
             : m_map{ t_map }
-            , m_width{ t_map.GetMapWidth() }
-            , m_height{ t_map.GetMapHeight() }
+            , m_gridSearch{ t_map.GetMapWidth(), t_map.GetMapHeight() }
         {
+            // the graphs of the other footprints are built with their first search
+            GetClusterGraph(AssetType::WATER_UNIT, 1);
+            GetClusterGraph(AssetType::LAND_UNIT, 1);
         }
 
         Astar(const Astar& t_other) = delete;
@@ -43,292 +97,423 @@ namespace sg::islands::iso
         ~Astar() noexcept = default;
 
         //-------------------------------------------------
-        // A* Pathfinding
+        // Strategy
         //-------------------------------------------------
 
-        std::vector<Node> FindPath(const Node& t_startNode, const Node& t_endNode, const AssetType& t_assetType)
-        {
-            m_assetType = t_assetType;
+        /**
+         * @brief Get the algorithm used by `FindPathToMapPosition()`.
+         * @return PathStrategy
+         */
+        auto GetStrategy() const { return m_strategy; }
 
-            std::vector<Node> empty;
+        /**
+         * @brief Set the algorithm used by `FindPathToMapPosition()`.
+         * @param t_strategy The `PathStrategy`.
+         */
+        void SetStrategy(const PathStrategy t_strategy) { m_strategy = t_strategy; }
 
-            if (!IsValid(t_endNode))
-            {
-                SG_ISLANDS_INFO("[Astar::FindPath()] Destination is an obstacle.");
-                return empty;
-            }
+        /**
+         * @brief Checks if the searches are kept for a comparison of A*, JPS and bidirectional A*.
+         * @return bool
+         */
+        auto IsCompareMode() const { return m_compareMode; }
+
+        /**
+         * @brief Enables or disables keeping the searches for a comparison.
+         * @param t_compareMode bool
+         */
+        void SetCompareMode(const bool t_compareMode) { m_compareMode = t_compareMode; }
 
-            if (IsEndNode(t_startNode, t_endNode))
+        /**
+         * @brief Keeps a search for `CompareLastQuery()`. Costs nothing more, so it can be called with each move order.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         */
+        void SetLastQuery(const sf::Vector2i& t_startPosition, const sf::Vector2i& t_targetPosition, const AssetType t_assetType, const int t_footprint)
+        {
+            if (m_compareMode)
             {
-                SG_ISLANDS_INFO("[Astar::FindPath()] You are the target.");
-                return empty;
+                m_lastQuery = { t_startPosition, t_targetPosition, t_assetType, t_footprint };
+                m_hasLastQuery = true;
             }
+        }
 
-            std::vector<bool> closedList;
-            std::vector<Node> allList;
+        /**
+         * @brief Checks if there is a search for `CompareLastQuery()`.
+         * @return bool
+         */
+        bool HasLastQuery() const noexcept { return m_hasLastQuery; }
+
+        /**
+         * @brief Get the result of the last comparison.
+         * @return Const reference to `PathComparison`
+         */
+        const PathComparison& GetLastComparison() const noexcept { return m_lastComparison; }
 
-            for (auto y{ 0 }; y < m_height; ++y)
+        //-------------------------------------------------
+        // A* Pathfinding
+        //-------------------------------------------------
+
+        /**
+         * @brief Finds a path with A*.
+         * @param t_startNode The start.
+         * @param t_endNode The target.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_path Receives all map positions from the start to the target; empty if no path was found.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @param t_bidirectional Search from both ends; pays off for long queries across the map.
+         * @return bool
+         */
+        bool FindPath(
+            const Node& t_startNode,
+            const Node& t_endNode,
+            const AssetType& t_assetType,
+            std::vector<Node>& t_path,
+            const int t_footprint = 1,
+            const bool t_bidirectional = false
+        )
+        {
+            if (t_bidirectional)
             {
-                for (auto x{ 0 }; x < m_width; ++x)
-                {
-                    Node node;
-                    node.position = sf::Vector2i(x, y);
-                    node.parentPosition = sf::Vector2i(-1, -1);
-                    node.g = std::numeric_limits<float>::max();
-                    node.h = std::numeric_limits<float>::max();
-                    node.f = std::numeric_limits<float>::max();
-
-                    allList.push_back(node);
-                    closedList.push_back(false);
-                }
+                return m_gridSearch.FindBidirectionalPath(m_map, t_startNode.position, t_endNode.position, t_assetType, t_path, t_footprint);
             }
 
-            assert(closedList.size() == static_cast<std::size_t>(m_width * m_height));
-            assert(allList.size() == static_cast<std::size_t>(m_width * m_height));
-
-            // init start node
-            auto xPos{ t_startNode.position.x };
-            auto yPos{ t_startNode.position.y };
-            auto index{ IsoMath::From2DTo1D(xPos, yPos, m_width) };
+            return m_gridSearch.FindPath(m_map, t_startNode, t_endNode, t_assetType, t_path, t_footprint);
+        }
 
-            allList[index].parentPosition.x = xPos;
-            allList[index].parentPosition.y = yPos;
-            allList[index].g = 0.0f;
-            allList[index].h = 0.0f;
-            allList[index].f = 0.0f;
+        /**
+         * @brief Finds a path with the current `PathStrategy`.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_path Receives all map positions from the start to the target.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return bool
+         */
+        bool FindPathToMapPosition(
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            std::vector<Node>& t_path,
+            const int t_footprint = 1
+        )
+        {
+            SetLastQuery(t_startPosition, t_targetPosition, t_assetType, t_footprint);
 
-            // add start node to open list
-            std::vector<Node> openList;
-            openList.push_back(allList[index]);
+            if (m_strategy == PathStrategy::JPS)
+            {
+                return FindJpsPath(t_startPosition, t_targetPosition, t_assetType, t_path, t_footprint);
+            }
 
-            // loop until find the end node
-            while (!openList.empty() && openList.size() < static_cast<std::size_t>(m_width * m_height))
+            if (m_strategy == PathStrategy::HIERARCHICAL)
             {
-                Node node;
-                do
+                AbstractPath abstractPath;
+                if (!FindAbstractPath(t_startPosition, t_targetPosition, t_assetType, abstractPath, t_footprint))
                 {
-                    auto tmp{ std::numeric_limits<float>::max() };
-                    std::vector<Node>::iterator itNode;
-                    for (auto it{ openList.begin() }; it != openList.end(); it = std::next(it))
-                    {
-                        const auto openListNode{ *it };
-                        if (openListNode.f < tmp)
-                        {
-                            tmp = openListNode.f;
-                            itNode = it;
-                        }
-                    }
-
-                    node = *itNode;
-                    openList.erase(itNode);
+                    t_path.clear();
+                    return false;
                 }
-                while (!IsValid(node));
 
-                xPos = node.position.x;
-                yPos = node.position.y;
-                index = IsoMath::From2DTo1D(xPos, yPos, m_width);
-
-                closedList[index] = true;
+                return RefinePath(t_assetType, t_footprint, abstractPath, t_path, INT_MAX);
+            }
 
-                // for each neighbour
-                for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
-                {
-                    for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
-                    {
-                        const auto newXPos{ xPos + xOffset };
-                        const auto newYPos{ yPos + yOffset };
-                        const auto newIndex{ IsoMath::From2DTo1D(newXPos, newYPos, m_width) };
-
-                        if (IsValid(newXPos, newYPos))
-                        {
-                            if (IsEndNode(newXPos, newYPos, t_endNode))
-                            {
-                                allList[newIndex].parentPosition.x = xPos;
-                                allList[newIndex].parentPosition.y = yPos;
-
-                                return MakePath(allList, t_endNode);
-                            }
-
-                            if (!closedList[newIndex])
-                            {
-                                const auto newG{ node.g + 1.0f };
-                                const auto newH{ CalculateHeuristic(newXPos, newYPos, t_endNode) };
-                                const auto newF{ newG + newH };
-
-                                // check if this path is better than the one already present
-                                if (allList[newIndex].f == std::numeric_limits<float>::max() ||
-                                    allList[newIndex].f > newF)
-                                {
-                                    // update the details of this neighbour node
-                                    allList[newIndex].parentPosition.x = xPos;
-                                    allList[newIndex].parentPosition.y = yPos;
-                                    allList[newIndex].g = newG;
-                                    allList[newIndex].h = newH;
-                                    allList[newIndex].f = newF;
-
-                                    openList.push_back(allList[newIndex]);
-                                }
-                            }
-                        }
-                    }
-                }
+            if (m_strategy == PathStrategy::INCREMENTAL)
+            {
+                return CreateIncrementalPlanner(t_startPosition, t_targetPosition, t_assetType, t_footprint)->ComputePath(t_path);
             }
 
-            // For example, you can not jump from one island to the other.
-            SG_ISLANDS_INFO("[Astar::FindPath()] Target not found.");
+            return FindAstarPath(t_startPosition, t_targetPosition, t_assetType, t_path, t_footprint);
+        }
+
+        /**
+         * @brief Runs the comparison on the search kept by `SetLastQuery()`. Called from the debug Gui,
+         *        so the three extra searches never delay a move order.
+         * @return Const reference to `PathComparison`
+         */
+        const PathComparison& CompareLastQuery()
+        {
+            if (!m_hasLastQuery)
+            {
+                return m_lastComparison;
+            }
 
-            return empty;
+            return ComparePaths(m_lastQuery.startPosition, m_lastQuery.targetPosition, m_lastQuery.assetType, m_lastQuery.footprint);
         }
 
-        bool FindPathToMapPosition(
+        /**
+         * @brief Runs A*, JPS and the bidirectional A* on the same query and logs the expanded nodes and the wall time.
+         *        Warns if the bidirectional path is not as short as the shortest unidirectional (JPS) path.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return Const reference to `PathComparison`
+         */
+        const PathComparison& ComparePaths(
             const sf::Vector2i& t_startPosition,
             const sf::Vector2i& t_targetPosition,
             const AssetType& t_assetType,
-            std::vector<Node>& t_path
+            const int t_footprint = 1
         )
         {
-            Node startNode;
-            Node endNode;
-
-            startNode.position = t_startPosition;
-            endNode.position = t_targetPosition;
-
-            t_path = FindPath(startNode, endNode, t_assetType);
+            std::vector<Node> path;
+
+            auto start{ std::chrono::steady_clock::now() };
+            FindAstarPath(t_startPosition, t_targetPosition, t_assetType, path, t_footprint);
+            auto end{ std::chrono::steady_clock::now() };
+
+            m_lastComparison.astar.expandedNodes = m_gridSearch.GetExpandedNodes();
+            m_lastComparison.astar.pathLength = path.size();
+            m_lastComparison.astar.microseconds = std::chrono::duration<double, std::micro>(end - start).count();
+
+            start = std::chrono::steady_clock::now();
+            FindJpsPath(t_startPosition, t_targetPosition, t_assetType, path, t_footprint);
+            end = std::chrono::steady_clock::now();
+
+            m_lastComparison.jps.expandedNodes = m_gridSearch.GetExpandedNodes();
+            m_lastComparison.jps.pathLength = path.size();
+            m_lastComparison.jps.microseconds = std::chrono::duration<double, std::micro>(end - start).count();
+
+            start = std::chrono::steady_clock::now();
+            m_gridSearch.FindBidirectionalPath(m_map, t_startPosition, t_targetPosition, t_assetType, path, t_footprint);
+            end = std::chrono::steady_clock::now();
+
+            m_lastComparison.bidirectional.expandedNodes = m_gridSearch.GetExpandedNodes();
+            m_lastComparison.bidirectional.pathLength = path.size();
+            m_lastComparison.bidirectional.microseconds = std::chrono::duration<double, std::micro>(end - start).count();
+
+            SG_ISLANDS_INFO("[Astar::ComparePaths()] A*: {} expanded nodes, path length {}, {:.1f} us.",
+                m_lastComparison.astar.expandedNodes, m_lastComparison.astar.pathLength, m_lastComparison.astar.microseconds);
+            SG_ISLANDS_INFO("[Astar::ComparePaths()] JPS: {} expanded nodes, path length {}, {:.1f} us.",
+                m_lastComparison.jps.expandedNodes, m_lastComparison.jps.pathLength, m_lastComparison.jps.microseconds);
+            SG_ISLANDS_INFO("[Astar::ComparePaths()] Bidirectional A*: {} expanded nodes, path length {}, {:.1f} us.",
+                m_lastComparison.bidirectional.expandedNodes, m_lastComparison.bidirectional.pathLength, m_lastComparison.bidirectional.microseconds);
+
+            // The unidirectional A* uses the Euclidean distance, which can overestimate the diagonal steps,
+            // so its path may be longer. JPS and the bidirectional A* both find a shortest path.
+            if (m_lastComparison.bidirectional.pathLength != m_lastComparison.jps.pathLength)
+            {
+                SG_ISLANDS_WARN("[Astar::ComparePaths()] The bidirectional path length {} differs from the unidirectional path length {}.",
+                    m_lastComparison.bidirectional.pathLength, m_lastComparison.jps.pathLength);
+            }
 
-            return !t_path.empty();
+            return m_lastComparison;
         }
 
-    protected:
-
-    private:
         /**
-         * @brief Rerence to `Map`.
+         * @brief Removes the waypoints of a path that can be skipped in a straight line.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         * @param t_path The grid path; the first node is the start.
+         * @param t_waypoints Receives the start, the remaining corners and the target.
          */
-        Map& m_map;
+        void SmoothPath(const AssetType t_assetType, const int t_footprint, const std::vector<Node>& t_path, Waypoints& t_waypoints) const
+        {
+            PathSmoother::Smooth(m_map, t_assetType, t_footprint, t_path, t_waypoints);
+        }
 
-        /**
-         * @brief The map width.
-         */
-        int m_width{ -1 };
+        //-------------------------------------------------
+        // Jump Point Search
+        //-------------------------------------------------
 
         /**
-         * @brief The map height.
+         * @brief Jump Point Search on the `Map`.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_path Receives all map positions from the start to the target.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return bool
          */
-        int m_height{ -1 };
+        bool FindJpsPath(
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            std::vector<Node>& t_path,
+            const int t_footprint = 1
+        )
+        {
+            return m_gridSearch.FindJpsPath(m_map, t_startPosition, t_targetPosition, t_assetType, t_path, t_footprint);
+        }
+
+        //-------------------------------------------------
+        // Incremental Pathfinding
+        //-------------------------------------------------
 
         /**
-         * @brief The current asset type using in `FindPath()`.
+         * @brief Creates a D* Lite planner. The unit keeps it to repair its path when the `Map` changes.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return DStarLiteUniquePtr
          */
-        AssetType m_assetType{ AssetType::NONE };
+        DStarLiteUniquePtr CreateIncrementalPlanner(
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            const int t_footprint = 1
+        ) const
+        {
+            return std::make_unique<DStarLite>(m_map, t_startPosition, t_targetPosition, t_assetType, t_footprint);
+        }
 
         //-------------------------------------------------
-        // Helper
+        // Hierarchical Pathfinding
         //-------------------------------------------------
 
-        std::vector<Node> MakePath(const std::vector<Node>& t_nodes, const Node& t_endNode) const
+        /**
+         * @brief Searches only the entrances between the clusters to pass.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_path Receives the abstract path. Use `RefinePath()` to get the map positions.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return bool
+         */
+        bool FindAbstractPath(
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            AbstractPath& t_path,
+            const int t_footprint = 1
+        )
         {
-            auto xPos{ t_endNode.position.x };
-            auto yPos{ t_endNode.position.y };
-            auto index{ IsoMath::From2DTo1D(xPos, yPos, m_width) };
-
-            std::stack<Node> path;
-            std::vector<Node> usablePath;
-
-            while (
-                !(t_nodes[index].parentPosition.x == xPos &&
-                    t_nodes[index].parentPosition.y == yPos) &&
-                t_nodes[index].position.x != -1 && t_nodes[index].position.y != -1
-                )
+            t_path.Clear();
+
+            if (t_startPosition == t_targetPosition)
             {
-                path.push(t_nodes[index]);
-                const auto tempX{ t_nodes[index].parentPosition.x };
-                const auto tempY{ t_nodes[index].parentPosition.y };
-                xPos = tempX;
-                yPos = tempY;
-                index = IsoMath::From2DTo1D(xPos, yPos, m_width);
+                SG_ISLANDS_INFO("[Astar::FindAbstractPath()] You are the target.");
+                return false;
             }
 
-            path.push(t_nodes[index]);
+            if (GetClusterGraph(t_assetType, t_footprint).FindAbstractPath(t_startPosition, t_targetPosition, t_path))
+            {
+                return true;
+            }
 
-            while (!path.empty())
+            if (!m_map.IsReachable(t_startPosition, t_targetPosition, t_assetType))
             {
-                auto top{ path.top() };
-                path.pop();
-                usablePath.push_back(top);
+                SG_ISLANDS_INFO("[Astar::FindAbstractPath()] Target not reachable.");
+                return false;
             }
 
-            return usablePath;
-        }
+            // the entrances only cover straight border crossings; a region that is only
+            // connected diagonally across a border is searched without the clusters
+            std::vector<Node> path;
+            if (!FindAstarPath(t_startPosition, t_targetPosition, t_assetType, path, t_footprint))
+            {
+                return false;
+            }
 
-        /**
-         * @brief Calculate the Euclidean distance from a position to the end node.
-         * @param t_x The x-position.
-         * @param t_y The y-position.
-         * @param t_endNode The end node.
-         * @return float
-         */
-        static float CalculateHeuristic(const int t_x, const int t_y, const Node& t_endNode)
-        {
-            const auto xd{ t_endNode.position.x - t_x };
-            const auto yd{ t_endNode.position.y - t_y };
+            for (const auto& node : path)
+            {
+                t_path.positions.push_back(node.position);
+            }
 
-            return static_cast<float>(sqrt(xd * xd + yd * yd)); // todo remove sqrt
+            return true;
         }
 
         /**
-         * @brief Checks if a position is valid.
-         * @param t_x The x-position.
-         * @param t_y The y-position.
+         * @brief Computes the map positions for the next clusters of an abstract path.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         * @param t_abstractPath The abstract path from `FindAbstractPath()`.
+         * @param t_path Receives the map positions, starting with the current position.
+         * @param t_maxClusters The number of clusters to refine.
          * @return bool
          */
-        bool IsValid(const int t_x, const int t_y) const
+        bool RefinePath(
+            const AssetType& t_assetType,
+            const int t_footprint,
+            AbstractPath& t_abstractPath,
+            std::vector<Node>& t_path,
+            const int t_maxClusters = REFINE_CLUSTERS
+        )
         {
-            if (t_x < 0 || t_y < 0 || t_x >= m_width || t_y >= m_height)
+            if (!GetClusterGraph(t_assetType, t_footprint).RefinePath(t_abstractPath, t_path, t_maxClusters))
             {
+                SG_ISLANDS_INFO("[Astar::RefinePath()] The path is blocked.");
+                t_path.clear();
                 return false;
             }
 
-            assert(m_assetType != AssetType::NONE);
+            return true;
+        }
 
-            if (m_assetType == AssetType::WATER_UNIT)
-            {
-                return m_map.IsDeepWater(t_x, t_y) && m_map.IsPassable(t_x, t_y);
-            }
+    protected:
 
-            return m_map.IsLand(t_x, t_y) && m_map.IsPassable(t_x, t_y);
-        }
+    private:
+        /**
+         * @brief Rerence to `Map`.
+         */
+        Map& m_map;
 
         /**
-         * @brief Checks if a position is valid.
-         * @param t_node A `Node`.
-         * @return bool
+         * @brief A* and JPS on the `Map`.
          */
-        bool IsValid(const Node& t_node) const
-        {
-            return IsValid(t_node.position.x, t_node.position.y);
-        }
+        GridSearch<Map> m_gridSearch;
 
         /**
-         * @brief Checks if the passed `Node` is the end `Node`.
-         * @param t_node A `Node`
-         * @param t_endNode The end `Node`
-         * @return bool
+         * @brief The algorithm used by `FindPathToMapPosition()`.
          */
-        static bool IsEndNode(const Node& t_node, const Node& t_endNode)
-        {
-            return t_node == t_endNode;
-        }
+        PathStrategy m_strategy{ PathStrategy::ASTAR };
 
         /**
-         * @brief Checks if the passed position is the end `Node`.
-         * @param t_x The x-position.
-         * @param t_y The y-position.
-         * @param t_endNode The end `Node`.
-         * @return bool
+         * @brief Keep the searches for a comparison of A* and JPS.
+         */
+        bool m_compareMode{ false };
+
+        /**
+         * @brief The search to compare.
+         */
+        PathQuery m_lastQuery;
+        bool m_hasLastQuery{ false };
+
+        /**
+         * @brief The result of the last comparison.
+         */
+        PathComparison m_lastComparison;
+
+        /**
+         * @brief The abstract graphs for each `AssetType` and footprint.
          */
-        static bool IsEndNode(const int t_x, const int t_y, const Node& t_endNode)
+        std::map<std::pair<AssetType, int>, std::unique_ptr<ClusterGraph>> m_clusterGraphs;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        bool FindAstarPath(
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            std::vector<Node>& t_path,
+            const int t_footprint = 1
+        )
         {
-            return t_x == t_endNode.position.x && t_y == t_endNode.position.y;
+            Node startNode;
+            Node endNode;
+
+            startNode.position = t_startPosition;
+            endNode.position = t_targetPosition;
+
+            return FindPath(startNode, endNode, t_assetType, t_path, t_footprint);
+        }
+
+        ClusterGraph& GetClusterGraph(const AssetType t_assetType, const int t_footprint)
+        {
+            assert(t_assetType == AssetType::WATER_UNIT || t_assetType == AssetType::LAND_UNIT);
+
+            auto& clusterGraph{ m_clusterGraphs[{ t_assetType, t_footprint }] };
+            if (!clusterGraph)
+            {
+                clusterGraph = std::make_unique<ClusterGraph>(m_map, t_assetType, t_footprint);
+            }
+
+            return *clusterGraph;
         }
     };
 }
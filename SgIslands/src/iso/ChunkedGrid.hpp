@@ -0,0 +1,269 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: ChunkedGrid.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief A value for each map field, stored in chunks of 32 x 32 values.
+     *        A copy shares all chunks and costs one pointer per chunk. The shared chunks are never
+     *        changed again: after a copy was made, each chunk is copied before its next change, so
+     *        another thread can read the copy without a lock. Works like the `MapFieldChunks`.
+     *        A `ChunkedGrid` must be copied in the thread that changes it.
+     *        After `Compact()` all chunks with the same value in each field share one chunk, so
+     *        e.g. the open sea costs one pointer per chunk.
+     *        The getters do not check the bounds.
+     * @tparam T The value type.
+     */
+    template <typename T>
+    class ChunkedGrid
+    {
+    public:
+        static constexpr int CHUNK_SIZE{ 32 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        ChunkedGrid() = default;
+
+        /**
+         * @brief Shares the chunks of another `ChunkedGrid`; from now on, both copy a chunk before changing it.
+         * @param t_other The grid to share.
+         */
+        ChunkedGrid(const ChunkedGrid& t_other)
+            : m_width{ t_other.m_width }
+            , m_height{ t_other.m_height }
+            , m_chunksX{ t_other.m_chunksX }
+            , m_chunks{ t_other.m_chunks }
+            , m_uniformChunks{ t_other.m_uniformChunks }
+            , m_chunkEpochs(t_other.m_chunkEpochs.size(), 0)
+            , m_epoch{ ++t_other.m_epoch }
+        {}
+
+        ChunkedGrid(ChunkedGrid&& t_other) noexcept = default;
+        ChunkedGrid& operator=(const ChunkedGrid& t_other) = delete;
+        ChunkedGrid& operator=(ChunkedGrid&& t_other) noexcept = default;
+
+        ~ChunkedGrid() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        int GetWidth() const noexcept { return m_width; }
+
+        int GetHeight() const noexcept { return m_height; }
+
+        /**
+         * @brief Get the number of chunks with own memory, i.e. not shared with other chunks of the grid.
+         * @return std::size_t
+         */
+        std::size_t GetNumberOfMaterializedChunks() const
+        {
+            std::size_t count{ 0 };
+
+            for (const auto& chunk : m_chunks)
+            {
+                count += IsUniformChunk(chunk) ? 0 : 1;
+            }
+
+            return count;
+        }
+
+        T Get(const int t_x, const int t_y) const
+        {
+            assert(t_x >= 0 && t_y >= 0 && t_x < m_width && t_y < m_height);
+
+            return (*m_chunks[GetChunkIndex(t_x, t_y)])[GetValueIndex(t_x, t_y)];
+        }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates the grid with the given size; all chunks share one chunk with the given value.
+         * @param t_width The width.
+         * @param t_height The height.
+         * @param t_value The value of all fields.
+         */
+        void Assign(const int t_width, const int t_height, const T& t_value)
+        {
+            m_width = t_width;
+            m_height = t_height;
+            m_chunksX = (t_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+            const auto chunksY{ (t_height + CHUNK_SIZE - 1) / CHUNK_SIZE };
+
+            m_uniformChunks.clear();
+
+            m_chunks.assign(static_cast<std::size_t>(m_chunksX * chunksY), GetUniformChunk(t_value));
+
+            // no chunk is owned yet
+            m_chunkEpochs.assign(m_chunks.size(), 0);
+            m_epoch = 1;
+        }
+
+        void Set(const int t_x, const int t_y, const T& t_value)
+        {
+            assert(t_x >= 0 && t_y >= 0 && t_x < m_width && t_y < m_height);
+
+            if (Get(t_x, t_y) == t_value)
+            {
+                return;
+            }
+
+            GetMutableChunk(t_x, t_y)[GetValueIndex(t_x, t_y)] = t_value;
+        }
+
+        /**
+         * @brief Replaces each chunk that has the same value in all its fields by the shared chunk
+         *        of this value. Call it after the values were computed for the whole grid.
+         *        The fields of the edge chunks outside the grid are not compared.
+         */
+        void Compact()
+        {
+            for (auto chunkY{ 0 }; chunkY * CHUNK_SIZE < m_height; ++chunkY)
+            {
+                for (auto chunkX{ 0 }; chunkX < m_chunksX; ++chunkX)
+                {
+                    const auto chunkIndex{ static_cast<std::size_t>(chunkY * m_chunksX + chunkX) };
+                    auto& chunk{ m_chunks[chunkIndex] };
+
+                    if (IsUniformChunk(chunk))
+                    {
+                        continue;
+                    }
+
+                    const auto width{ std::min(CHUNK_SIZE, m_width - chunkX * CHUNK_SIZE) };
+                    const auto height{ std::min(CHUNK_SIZE, m_height - chunkY * CHUNK_SIZE) };
+
+                    if (!IsUniform(*chunk, width, height))
+                    {
+                        continue;
+                    }
+
+                    chunk = GetUniformChunk((*chunk)[0]);
+
+                    // the shared chunk is never owned, so it is copied before a change
+                    m_chunkEpochs[chunkIndex] = 0;
+                }
+            }
+        }
+
+    protected:
+
+    private:
+        using Chunk = std::array<T, CHUNK_SIZE * CHUNK_SIZE>;
+
+        int m_width{ 0 };
+        int m_height{ 0 };
+        int m_chunksX{ 0 };
+
+        /**
+         * @brief The chunks row by row.
+         */
+        std::vector<std::shared_ptr<Chunk>> m_chunks;
+
+        /**
+         * @brief One shared chunk for each value that fills a whole chunk.
+         */
+        std::map<T, std::shared_ptr<Chunk>> m_uniformChunks;
+
+        /**
+         * @brief For each chunk, the epoch in which it was copied for changes; zero if it was never copied.
+         */
+        std::vector<std::uint32_t> m_chunkEpochs;
+
+        /**
+         * @brief Incremented with each copy of the grid. A chunk copied in an older epoch may be
+         *        shared and must be copied again before a change.
+         */
+        mutable std::uint32_t m_epoch{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        std::size_t GetChunkIndex(const int t_x, const int t_y) const
+        {
+            return static_cast<std::size_t>(t_y / CHUNK_SIZE * m_chunksX + t_x / CHUNK_SIZE);
+        }
+
+        static std::size_t GetValueIndex(const int t_x, const int t_y)
+        {
+            return static_cast<std::size_t>(t_y % CHUNK_SIZE * CHUNK_SIZE + t_x % CHUNK_SIZE);
+        }
+
+        /**
+         * @brief Returns the shared chunk filled with a value; it is created on first use.
+         */
+        std::shared_ptr<Chunk> GetUniformChunk(const T& t_value)
+        {
+            auto& chunk{ m_uniformChunks[t_value] };
+
+            if (!chunk)
+            {
+                chunk = std::make_shared<Chunk>();
+                chunk->fill(t_value);
+            }
+
+            return chunk;
+        }
+
+        bool IsUniformChunk(const std::shared_ptr<Chunk>& t_chunk) const
+        {
+            const auto it{ m_uniformChunks.find((*t_chunk)[0]) };
+
+            return it != m_uniformChunks.end() && it->second == t_chunk;
+        }
+
+        static bool IsUniform(const Chunk& t_chunk, const int t_width, const int t_height)
+        {
+            for (auto y{ 0 }; y < t_height; ++y)
+            {
+                for (auto x{ 0 }; x < t_width; ++x)
+                {
+                    if (!(t_chunk[static_cast<std::size_t>(y * CHUNK_SIZE + x)] == t_chunk[0]))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        Chunk& GetMutableChunk(const int t_x, const int t_y)
+        {
+            const auto chunkIndex{ GetChunkIndex(t_x, t_y) };
+            auto& chunk{ m_chunks[chunkIndex] };
+
+            if (m_chunkEpochs[chunkIndex] != m_epoch)
+            {
+                chunk = std::make_shared<Chunk>(*chunk);
+                m_chunkEpochs[chunkIndex] = m_epoch;
+            }
+
+            return *chunk;
+        }
+    };
+}
@@ -0,0 +1,170 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: ClearanceMap.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include "ChunkedGrid.hpp"
+#include "IsoMath.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief Stores for each cell the size of the largest walkable square whose top left corner is the cell.
+     *        A unit with a footprint of n x n cells fits on a position if the square centered
+     *        on the position has a clearance of at least n, which is an O(1) lookup.
+     *        The walkability is passed as callable `bool(int x, int y)`.
+     *        The clearances are kept in a `ChunkedGrid`, so a copy of them is cheap.
+     */
+    class ClearanceMap
+    {
+    public:
+        using Clearance = std::uint8_t;
+
+        /**
+         * @brief The clearance is capped, so a change only touches the cells up to this distance.
+         */
+        static constexpr Clearance MAX_CLEARANCE{ 8 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        ClearanceMap() = default;
+
+        ClearanceMap(const ClearanceMap& t_other) = delete;
+        ClearanceMap(ClearanceMap&& t_other) noexcept = delete;
+        ClearanceMap& operator=(const ClearanceMap& t_other) = delete;
+        ClearanceMap& operator=(ClearanceMap&& t_other) noexcept = delete;
+
+        ~ClearanceMap() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Returns the clearance of a cell; zero for a blocked cell or outside the map.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @return Clearance
+         */
+        Clearance GetClearance(const int t_mapX, const int t_mapY) const
+        {
+            if (t_mapX < 0 || t_mapY < 0 || t_mapX >= m_width || t_mapY >= m_height)
+            {
+                return 0;
+            }
+
+            return m_clearances.Get(t_mapX, t_mapY);
+        }
+
+        /**
+         * @brief Returns the clearance per cell.
+         * @return Const reference to `ChunkedGrid`
+         */
+        const ChunkedGrid<Clearance>& GetClearances() const noexcept { return m_clearances; }
+
+        /**
+         * @brief Checks if a footprint centered on a cell is walkable.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_footprint The width and height of the unit in cells.
+         * @return bool
+         */
+        bool Fits(const int t_mapX, const int t_mapY, const int t_footprint) const
+        {
+            assert(t_footprint >= 1 && t_footprint <= MAX_CLEARANCE);
+
+            const auto offset{ (t_footprint - 1) / 2 };
+
+            return GetClearance(t_mapX - offset, t_mapY - offset) >= t_footprint;
+        }
+
+        //-------------------------------------------------
+        // Build && Update
+        //-------------------------------------------------
+
+        /**
+         * @brief Computes the clearance of all cells.
+         * @tparam TWalkable Callable `bool(int x, int y)`.
+         * @param t_width The map width.
+         * @param t_height The map height.
+         * @param t_isWalkable The walkability.
+         */
+        template <typename TWalkable>
+        void Build(const int t_width, const int t_height, TWalkable t_isWalkable)
+        {
+            m_width = t_width;
+            m_height = t_height;
+            m_clearances.Assign(m_width, m_height, 0);
+
+            Compute(0, 0, m_width - 1, m_height - 1, t_isWalkable);
+
+            // the chunks of the open sea share one chunk again
+            m_clearances.Compact();
+        }
+
+        /**
+         * @brief Recomputes the clearance after the walkability of one cell has changed.
+         *        Only the cells above and left of the cell can see it in their square.
+         * @tparam TWalkable Callable `bool(int x, int y)`.
+         * @param t_mapX The x-map position of the changed cell.
+         * @param t_mapY The y-map position of the changed cell.
+         * @param t_isWalkable The walkability.
+         */
+        template <typename TWalkable>
+        void Update(const int t_mapX, const int t_mapY, TWalkable t_isWalkable)
+        {
+            Compute(
+                std::max(0, t_mapX - MAX_CLEARANCE + 1),
+                std::max(0, t_mapY - MAX_CLEARANCE + 1),
+                t_mapX,
+                t_mapY,
+                t_isWalkable
+            );
+        }
+
+    protected:
+
+    private:
+        int m_width{ 0 };
+        int m_height{ 0 };
+
+        ChunkedGrid<Clearance> m_clearances;
+
+        /**
+         * @brief Computes a rectangle from the bottom right to the top left, so the right and lower
+         *        neighbours of a cell are always up to date.
+         */
+        template <typename TWalkable>
+        void Compute(const int t_minX, const int t_minY, const int t_maxX, const int t_maxY, TWalkable t_isWalkable)
+        {
+            for (auto y{ t_maxY }; y >= t_minY; --y)
+            {
+                for (auto x{ t_maxX }; x >= t_minX; --x)
+                {
+                    Clearance clearance{ 0 };
+
+                    if (t_isWalkable(x, y))
+                    {
+                        const auto smallest{ std::min({ GetClearance(x + 1, y), GetClearance(x, y + 1), GetClearance(x + 1, y + 1) }) };
+                        clearance = static_cast<Clearance>(std::min<int>(smallest + 1, MAX_CLEARANCE));
+                    }
+
+                    m_clearances.Set(x, y, clearance);
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,828 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: ClusterGraph.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+#include "AbstractPath.hpp"
+#include "Node.hpp"
+#include "Map.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief The abstract graph for hierarchical pathfinding (HPA*) of one type of unit.
+     *        The `Map` is split into square clusters. Each walkable run along a cluster border
+     *        gets one or two entrances, that is a pair of nodes on both sides of the border.
+     *        The nodes of a cluster are connected by their precomputed distances inside the cluster.
+     *        A search first runs on this small graph; the map positions between the nodes are
+     *        filled in later with a search limited to a single cluster.
+     *        A graph is built for one footprint; its entrances and distances only use the map
+     *        positions on which a unit of this size fits.
+     */
+    class ClusterGraph
+    {
+    public:
+        using NodeId = int;
+        using ClusterIndex = int;
+
+        static constexpr NodeId NO_NODE{ -1 };
+        static constexpr auto DEFAULT_CLUSTER_SIZE{ 10 };
+
+        /**
+         * @brief Runs with at least this width get an entrance at both ends instead of one in the middle.
+         */
+        static constexpr auto MIN_WIDE_ENTRANCE{ 6 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        ClusterGraph() = delete;
+
+        ClusterGraph(Map& t_map, const AssetType t_assetType, const int t_footprint = 1, const int t_clusterSize = DEFAULT_CLUSTER_SIZE)
+            : m_map{ t_map }
+            , m_assetType{ t_assetType }
+            , m_footprint{ t_footprint }
+            , m_clusterSize{ t_clusterSize }
+        {
+            assert(m_assetType == AssetType::WATER_UNIT || m_assetType == AssetType::LAND_UNIT);
+            assert(m_footprint >= 1);
+            assert(m_clusterSize > 1);
+
+            Init();
+
+            // only the clusters with changed map fields are rebuilt on the next search
+            m_map.AddChangeListener([this](const int t_mapX, const int t_mapY)
+            {
+                MarkDirty(t_mapX, t_mapY);
+            });
+        }
+
+        ClusterGraph(const ClusterGraph& t_other) = delete;
+        ClusterGraph(ClusterGraph&& t_other) noexcept = delete;
+        ClusterGraph& operator=(const ClusterGraph& t_other) = delete;
+        ClusterGraph& operator=(ClusterGraph&& t_other) noexcept = delete;
+
+        ~ClusterGraph() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        auto GetClusterSize() const { return m_clusterSize; }
+
+        auto GetFootprint() const { return m_footprint; }
+
+        auto GetNumberOfClusters() const { return m_clustersX * m_clustersY; }
+
+        /**
+         * @brief Returns the number of entrance nodes.
+         * @return std::size_t
+         */
+        std::size_t GetNumberOfNodes() const noexcept
+        {
+            return m_nodes.size() - m_freeNodes.size();
+        }
+
+        /**
+         * @brief Returns the cluster of a map position.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @return ClusterIndex
+         */
+        ClusterIndex GetClusterIndex(const int t_mapX, const int t_mapY) const
+        {
+            return (t_mapY / m_clusterSize) * m_clustersX + t_mapX / m_clusterSize;
+        }
+
+        ClusterIndex GetClusterIndex(const sf::Vector2i& t_mapPosition) const
+        {
+            return GetClusterIndex(t_mapPosition.x, t_mapPosition.y);
+        }
+
+        //-------------------------------------------------
+        // Update
+        //-------------------------------------------------
+
+        /**
+         * @brief Marks the clusters of a changed map field. With a larger footprint, the change
+         *        also decides whether the unit fits on the surrounding map positions.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         */
+        void MarkDirty(const int t_mapX, const int t_mapY)
+        {
+            // the positions whose footprint square contains the changed map field
+            const auto offset{ (m_footprint - 1) / 2 };
+            const auto minX{ std::max(t_mapX + offset - m_footprint + 1, 0) };
+            const auto minY{ std::max(t_mapY + offset - m_footprint + 1, 0) };
+            const auto maxX{ std::min(t_mapX + offset, m_map.GetMapWidth() - 1) };
+            const auto maxY{ std::min(t_mapY + offset, m_map.GetMapHeight() - 1) };
+
+            for (auto clusterY{ minY / m_clusterSize }; clusterY <= maxY / m_clusterSize; ++clusterY)
+            {
+                for (auto clusterX{ minX / m_clusterSize }; clusterX <= maxX / m_clusterSize; ++clusterX)
+                {
+                    MarkClusterDirty(clusterY * m_clustersX + clusterX);
+                }
+            }
+        }
+
+        /**
+         * @brief Rebuilds the entrances and distances of the dirty clusters.
+         *        The neighbours of a dirty cluster only get new distances.
+         */
+        void Update()
+        {
+            if (m_dirtyClusters.empty())
+            {
+                return;
+            }
+
+            std::vector<ClusterIndex> changedClusters;
+
+            for (const auto clusterIndex : m_dirtyClusters)
+            {
+                for (const auto borderIndex : m_clusterBorders[clusterIndex])
+                {
+                    if (m_borderDone[borderIndex])
+                    {
+                        continue;
+                    }
+
+                    m_borderDone[borderIndex] = true;
+                    BuildBorder(borderIndex);
+
+                    for (const auto changedCluster : { m_borders[borderIndex].first, m_borders[borderIndex].second })
+                    {
+                        if (!m_clusterDone[changedCluster])
+                        {
+                            m_clusterDone[changedCluster] = true;
+                            changedClusters.push_back(changedCluster);
+                        }
+                    }
+                }
+
+                m_dirty[clusterIndex] = false;
+            }
+
+            for (const auto clusterIndex : changedClusters)
+            {
+                BuildCluster(clusterIndex);
+                m_clusterDone[clusterIndex] = false;
+            }
+
+            std::fill(m_borderDone.begin(), m_borderDone.end(), false);
+
+            SG_ISLANDS_DEBUG("[ClusterGraph::Update()] Rebuilt {} dirty clusters, {} nodes.", m_dirtyClusters.size(), GetNumberOfNodes());
+
+            m_dirtyClusters.clear();
+        }
+
+        //-------------------------------------------------
+        // Search
+        //-------------------------------------------------
+
+        /**
+         * @brief Searches the abstract graph.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_path Receives the start, the entrances to pass and the target.
+         * @return bool
+         */
+        bool FindAbstractPath(const sf::Vector2i& t_startPosition, const sf::Vector2i& t_targetPosition, AbstractPath& t_path)
+        {
+            t_path.Clear();
+
+            Update();
+
+            // the start is left even if the unit does not fit there
+            if (!IsWalkable(t_targetPosition.x, t_targetPosition.y) ||
+                !m_map.IsReachable(t_startPosition, t_targetPosition, m_assetType))
+            {
+                return false;
+            }
+
+            const auto startCluster{ GetClusterIndex(t_startPosition) };
+            const auto targetCluster{ GetClusterIndex(t_targetPosition) };
+
+            // the start and the target are added as two temporary nodes
+            const auto startId{ static_cast<NodeId>(m_nodes.size()) };
+            const auto targetId{ startId + 1 };
+            const auto numberOfIds{ static_cast<std::size_t>(targetId + 1) };
+
+            // distances from the target to the entrances of its cluster
+            m_targetDistances.assign(m_nodes.size(), -1);
+            Flood(t_targetPosition, targetCluster);
+            for (const auto nodeId : m_clusterNodes[targetCluster])
+            {
+                m_targetDistances[nodeId] = GetFloodDistance(m_nodes[nodeId].position);
+            }
+
+            // distances from the start to the entrances of its cluster
+            m_startDistances.assign(m_nodes.size(), -1);
+            Flood(t_startPosition, startCluster);
+            for (const auto nodeId : m_clusterNodes[startCluster])
+            {
+                m_startDistances[nodeId] = GetFloodDistance(m_nodes[nodeId].position);
+            }
+
+            const auto directDistance{ startCluster == targetCluster ? GetFloodDistance(t_targetPosition) : -1 };
+
+            m_g.assign(numberOfIds, INT_MAX);
+            m_parents.assign(numberOfIds, NO_NODE);
+            m_closed.assign(numberOfIds, false);
+
+            const auto getPosition = [&](const NodeId t_id)
+            {
+                if (t_id == startId)
+                {
+                    return t_startPosition;
+                }
+
+                return t_id == targetId ? t_targetPosition : m_nodes[t_id].position;
+            };
+
+            using Entry = std::pair<int, NodeId>;
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<>> openList;
+
+            const auto relax = [&](const NodeId t_from, const NodeId t_to, const int t_cost)
+            {
+                const auto g{ m_g[t_from] + t_cost };
+                if (!m_closed[t_to] && g < m_g[t_to])
+                {
+                    m_g[t_to] = g;
+                    m_parents[t_to] = t_from;
+                    openList.emplace(g + Distance(getPosition(t_to), t_targetPosition), t_to);
+                }
+            };
+
+            m_g[startId] = 0;
+            openList.emplace(Distance(t_startPosition, t_targetPosition), startId);
+
+            while (!openList.empty())
+            {
+                const auto id{ openList.top().second };
+                openList.pop();
+
+                if (m_closed[id])
+                {
+                    continue;
+                }
+
+                if (id == targetId)
+                {
+                    for (auto current{ targetId }; current != NO_NODE; current = m_parents[current])
+                    {
+                        const auto position{ getPosition(current) };
+                        if (t_path.positions.empty() || t_path.positions.back() != position)
+                        {
+                            t_path.positions.push_back(position);
+                        }
+                    }
+
+                    std::reverse(t_path.positions.begin(), t_path.positions.end());
+
+                    return true;
+                }
+
+                m_closed[id] = true;
+
+                if (id == startId)
+                {
+                    for (const auto nodeId : m_clusterNodes[startCluster])
+                    {
+                        if (m_startDistances[nodeId] >= 0)
+                        {
+                            relax(id, nodeId, m_startDistances[nodeId]);
+                        }
+                    }
+
+                    if (directDistance >= 0)
+                    {
+                        relax(id, targetId, directDistance);
+                    }
+
+                    continue;
+                }
+
+                const auto& node{ m_nodes[id] };
+
+                relax(id, node.partner, 1);
+
+                for (const auto& edge : node.edges)
+                {
+                    relax(id, edge.to, edge.cost);
+                }
+
+                if (m_targetDistances[id] >= 0)
+                {
+                    relax(id, targetId, m_targetDistances[id]);
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Converts the next part of an abstract path into map positions.
+         * @param t_path The abstract path. Its refined positions are consumed.
+         * @param t_nodes Receives the map positions, starting with the current position.
+         * @param t_maxClusters The number of clusters to cross at most.
+         * @return bool False if the map has changed in the meantime and the path is blocked.
+         */
+        bool RefinePath(AbstractPath& t_path, std::vector<Node>& t_nodes, const int t_maxClusters)
+        {
+            t_nodes.clear();
+
+            if (t_path.IsComplete())
+            {
+                return false;
+            }
+
+            Update();
+
+            AddNode(t_path.positions[t_path.next], t_nodes);
+
+            auto clusters{ 0 };
+            while (!t_path.IsComplete() && clusters < t_maxClusters)
+            {
+                const auto& from{ t_path.positions[t_path.next] };
+                const auto& to{ t_path.positions[t_path.next + 1] };
+
+                if (Distance(from, to) <= 1)
+                {
+                    if (!IsWalkable(to.x, to.y))
+                    {
+                        t_path.Clear();
+                        return false;
+                    }
+
+                    AddNode(to, t_nodes);
+                }
+                else
+                {
+                    const auto clusterIndex{ GetClusterIndex(from) };
+                    assert(clusterIndex == GetClusterIndex(to));
+
+                    // flood from the end, so that the parents lead from `from` to `to`
+                    Flood(to, clusterIndex);
+                    if (GetFloodDistance(from) < 0)
+                    {
+                        t_path.Clear();
+                        return false;
+                    }
+
+                    for (auto position{ GetFloodParent(from) }; ; position = GetFloodParent(position))
+                    {
+                        AddNode(position, t_nodes);
+
+                        if (position == to)
+                        {
+                            break;
+                        }
+                    }
+
+                    clusters++;
+                }
+
+                t_path.next++;
+            }
+
+            return true;
+        }
+
+    protected:
+
+    private:
+        struct Edge
+        {
+            NodeId to;
+            int cost;
+        };
+
+        struct ClusterNode
+        {
+            sf::Vector2i position;
+            ClusterIndex clusterIndex;
+
+            /**
+             * @brief The node on the other side of the border.
+             */
+            NodeId partner;
+
+            /**
+             * @brief The other nodes of the cluster with their distances.
+             */
+            std::vector<Edge> edges;
+        };
+
+        struct Border
+        {
+            ClusterIndex first;
+            ClusterIndex second;
+
+            /**
+             * @brief True if `second` is right of `first`, otherwise `second` is below.
+             */
+            bool vertical;
+
+            /**
+             * @brief The entrance nodes; always pairs of a node in `first` and in `second`.
+             */
+            std::vector<NodeId> nodes;
+        };
+
+        /**
+         * @brief Reference to `Map`.
+         */
+        Map& m_map;
+
+        /**
+         * @brief The type of unit for which the graph is build.
+         */
+        AssetType m_assetType;
+
+        /**
+         * @brief The width and height of the units in map fields.
+         */
+        int m_footprint;
+
+        /**
+         * @brief The width and height of a cluster in map fields.
+         */
+        int m_clusterSize;
+
+        int m_clustersX{ 0 };
+        int m_clustersY{ 0 };
+
+        std::vector<ClusterNode> m_nodes;
+        std::vector<NodeId> m_freeNodes;
+        std::vector<Border> m_borders;
+
+        std::vector<std::vector<int>> m_clusterBorders;
+        std::vector<std::vector<NodeId>> m_clusterNodes;
+
+        std::vector<bool> m_dirty;
+        std::vector<ClusterIndex> m_dirtyClusters;
+        std::vector<bool> m_borderDone;
+        std::vector<bool> m_clusterDone;
+
+        // search state; kept to avoid allocations
+        std::vector<int> m_g;
+        std::vector<NodeId> m_parents;
+        std::vector<bool> m_closed;
+        std::vector<int> m_startDistances;
+        std::vector<int> m_targetDistances;
+
+        // flood fill inside a cluster; kept to avoid allocations
+        sf::Vector2i m_floodOrigin;
+        int m_floodWidth{ 0 };
+        std::vector<int> m_floodDistances;
+        std::vector<int> m_floodParents;
+        std::vector<int> m_floodQueue;
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        void Init()
+        {
+            const auto mapWidth{ m_map.GetMapWidth() };
+            const auto mapHeight{ m_map.GetMapHeight() };
+
+            m_clustersX = (mapWidth + m_clusterSize - 1) / m_clusterSize;
+            m_clustersY = (mapHeight + m_clusterSize - 1) / m_clusterSize;
+
+            const auto numberOfClusters{ static_cast<std::size_t>(GetNumberOfClusters()) };
+
+            m_clusterBorders.resize(numberOfClusters);
+            m_clusterNodes.resize(numberOfClusters);
+            m_dirty.assign(numberOfClusters, false);
+            m_clusterDone.assign(numberOfClusters, false);
+
+            for (auto y{ 0 }; y < m_clustersY; ++y)
+            {
+                for (auto x{ 0 }; x < m_clustersX; ++x)
+                {
+                    const auto clusterIndex{ y * m_clustersX + x };
+
+                    if (x + 1 < m_clustersX)
+                    {
+                        AddBorder(clusterIndex, clusterIndex + 1, true);
+                    }
+
+                    if (y + 1 < m_clustersY)
+                    {
+                        AddBorder(clusterIndex, clusterIndex + m_clustersX, false);
+                    }
+                }
+            }
+
+            m_borderDone.assign(m_borders.size(), false);
+            m_floodDistances.resize(static_cast<std::size_t>(m_clusterSize * m_clusterSize));
+            m_floodParents.resize(static_cast<std::size_t>(m_clusterSize * m_clusterSize));
+
+            // build everything
+            for (auto clusterIndex{ 0 }; clusterIndex < GetNumberOfClusters(); ++clusterIndex)
+            {
+                MarkClusterDirty(clusterIndex);
+            }
+
+            Update();
+
+            SG_ISLANDS_INFO("[ClusterGraph::Init()] Created {} clusters with {} entrance nodes for footprint {}.", GetNumberOfClusters(), GetNumberOfNodes(), m_footprint);
+        }
+
+        void MarkClusterDirty(const ClusterIndex t_clusterIndex)
+        {
+            if (!m_dirty[t_clusterIndex])
+            {
+                m_dirty[t_clusterIndex] = true;
+                m_dirtyClusters.push_back(t_clusterIndex);
+            }
+        }
+
+        void AddBorder(const ClusterIndex t_first, const ClusterIndex t_second, const bool t_vertical)
+        {
+            const auto borderIndex{ static_cast<int>(m_borders.size()) };
+
+            m_borders.push_back(Border{ t_first, t_second, t_vertical, {} });
+            m_clusterBorders[t_first].push_back(borderIndex);
+            m_clusterBorders[t_second].push_back(borderIndex);
+        }
+
+        //-------------------------------------------------
+        // Build
+        //-------------------------------------------------
+
+        NodeId NewNode(const sf::Vector2i& t_position, const ClusterIndex t_clusterIndex)
+        {
+            NodeId id;
+
+            if (!m_freeNodes.empty())
+            {
+                id = m_freeNodes.back();
+                m_freeNodes.pop_back();
+            }
+            else
+            {
+                id = static_cast<NodeId>(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+
+            m_nodes[id].position = t_position;
+            m_nodes[id].clusterIndex = t_clusterIndex;
+            m_nodes[id].partner = NO_NODE;
+            m_nodes[id].edges.clear();
+
+            return id;
+        }
+
+        /**
+         * @brief Finds the entrances of a border.
+         * @param t_borderIndex The index of the border.
+         */
+        void BuildBorder(const int t_borderIndex)
+        {
+            auto& border{ m_borders[t_borderIndex] };
+
+            for (const auto nodeId : border.nodes)
+            {
+                m_nodes[nodeId].clusterIndex = -1;
+                m_freeNodes.push_back(nodeId);
+            }
+
+            border.nodes.clear();
+
+            const auto firstX{ border.first % m_clustersX };
+            const auto firstY{ border.first / m_clustersX };
+
+            // the first field on the `first` side and the step along the border
+            sf::Vector2i position;
+            sf::Vector2i step;
+            sf::Vector2i across;
+            int length;
+
+            if (border.vertical)
+            {
+                position = sf::Vector2i((firstX + 1) * m_clusterSize - 1, firstY * m_clusterSize);
+                step = sf::Vector2i(0, 1);
+                across = sf::Vector2i(1, 0);
+                length = std::min(m_clusterSize, m_map.GetMapHeight() - position.y);
+            }
+            else
+            {
+                position = sf::Vector2i(firstX * m_clusterSize, (firstY + 1) * m_clusterSize - 1);
+                step = sf::Vector2i(1, 0);
+                across = sf::Vector2i(0, 1);
+                length = std::min(m_clusterSize, m_map.GetMapWidth() - position.x);
+            }
+
+            const auto isOpen = [&](const int t_i)
+            {
+                const auto a{ position + step * t_i };
+                const auto b{ a + across };
+
+                return IsWalkable(a.x, a.y) && IsWalkable(b.x, b.y);
+            };
+
+            const auto addEntrance = [&](const int t_i)
+            {
+                const auto a{ position + step * t_i };
+                const auto firstNode{ NewNode(a, border.first) };
+                const auto secondNode{ NewNode(a + across, border.second) };
+
+                m_nodes[firstNode].partner = secondNode;
+                m_nodes[secondNode].partner = firstNode;
+
+                border.nodes.push_back(firstNode);
+                border.nodes.push_back(secondNode);
+            };
+
+            auto i{ 0 };
+            while (i < length)
+            {
+                if (!isOpen(i))
+                {
+                    i++;
+                    continue;
+                }
+
+                const auto begin{ i };
+                while (i < length && isOpen(i))
+                {
+                    i++;
+                }
+
+                const auto end{ i - 1 };
+
+                if (end - begin + 1 >= MIN_WIDE_ENTRANCE)
+                {
+                    addEntrance(begin);
+                    addEntrance(end);
+                }
+                else
+                {
+                    addEntrance((begin + end) / 2);
+                }
+            }
+        }
+
+        /**
+         * @brief Collects the nodes of a cluster and computes the distances between them.
+         * @param t_clusterIndex The index of the cluster.
+         */
+        void BuildCluster(const ClusterIndex t_clusterIndex)
+        {
+            auto& clusterNodes{ m_clusterNodes[t_clusterIndex] };
+            clusterNodes.clear();
+
+            for (const auto borderIndex : m_clusterBorders[t_clusterIndex])
+            {
+                for (const auto nodeId : m_borders[borderIndex].nodes)
+                {
+                    if (m_nodes[nodeId].clusterIndex == t_clusterIndex)
+                    {
+                        clusterNodes.push_back(nodeId);
+                    }
+                }
+            }
+
+            for (const auto nodeId : clusterNodes)
+            {
+                auto& node{ m_nodes[nodeId] };
+                node.edges.clear();
+
+                Flood(node.position, t_clusterIndex);
+
+                for (const auto otherId : clusterNodes)
+                {
+                    const auto distance{ GetFloodDistance(m_nodes[otherId].position) };
+                    if (otherId != nodeId && distance >= 0)
+                    {
+                        node.edges.push_back(Edge{ otherId, distance });
+                    }
+                }
+            }
+        }
+
+        //-------------------------------------------------
+        // Flood fill
+        //-------------------------------------------------
+
+        /**
+         * @brief Breadth-first search from a position; limited to the cluster.
+         * @param t_position The start map position.
+         * @param t_clusterIndex The index of the cluster.
+         */
+        void Flood(const sf::Vector2i& t_position, const ClusterIndex t_clusterIndex)
+        {
+            m_floodOrigin = sf::Vector2i((t_clusterIndex % m_clustersX) * m_clusterSize, (t_clusterIndex / m_clustersX) * m_clusterSize);
+            m_floodWidth = std::min(m_clusterSize, m_map.GetMapWidth() - m_floodOrigin.x);
+            const auto floodHeight{ std::min(m_clusterSize, m_map.GetMapHeight() - m_floodOrigin.y) };
+
+            std::fill(m_floodDistances.begin(), m_floodDistances.end(), -1);
+
+            m_floodQueue.clear();
+            m_floodQueue.push_back(ToLocal(t_position));
+            m_floodDistances[m_floodQueue.back()] = 0;
+            m_floodParents[m_floodQueue.back()] = m_floodQueue.back();
+
+            for (std::size_t i{ 0 }; i < m_floodQueue.size(); ++i)
+            {
+                const auto local{ m_floodQueue[i] };
+                const auto x{ local % m_floodWidth };
+                const auto y{ local / m_floodWidth };
+
+                for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+                {
+                    for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                    {
+                        const auto nx{ x + xOffset };
+                        const auto ny{ y + yOffset };
+
+                        if (nx < 0 || ny < 0 || nx >= m_floodWidth || ny >= floodHeight)
+                        {
+                            continue;
+                        }
+
+                        const auto nLocal{ ny * m_floodWidth + nx };
+                        if (m_floodDistances[nLocal] < 0 &&
+                            IsWalkable(m_floodOrigin.x + nx, m_floodOrigin.y + ny))
+                        {
+                            m_floodDistances[nLocal] = m_floodDistances[local] + 1;
+                            m_floodParents[nLocal] = local;
+                            m_floodQueue.push_back(nLocal);
+                        }
+                    }
+                }
+            }
+        }
+
+        int ToLocal(const sf::Vector2i& t_position) const
+        {
+            return (t_position.y - m_floodOrigin.y) * m_floodWidth + t_position.x - m_floodOrigin.x;
+        }
+
+        /**
+         * @brief Returns the distance to the last flood origin or -1 if not reached.
+         */
+        int GetFloodDistance(const sf::Vector2i& t_position) const
+        {
+            return m_floodDistances[ToLocal(t_position)];
+        }
+
+        sf::Vector2i GetFloodParent(const sf::Vector2i& t_position) const
+        {
+            const auto parent{ m_floodParents[ToLocal(t_position)] };
+
+            return sf::Vector2i(m_floodOrigin.x + parent % m_floodWidth, m_floodOrigin.y + parent / m_floodWidth);
+        }
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * @brief Checks if a unit with the footprint of the graph fits on a map position.
+         */
+        bool IsWalkable(const int t_mapX, const int t_mapY) const
+        {
+            return m_map.IsWalkable(t_mapX, t_mapY, m_assetType, m_footprint);
+        }
+
+        /**
+         * @brief The number of steps on an empty 8-connected grid.
+         */
+        static int Distance(const sf::Vector2i& t_from, const sf::Vector2i& t_to)
+        {
+            return std::max(std::abs(t_from.x - t_to.x), std::abs(t_from.y - t_to.y));
+        }
+
+        static void AddNode(const sf::Vector2i& t_position, std::vector<Node>& t_nodes)
+        {
+            Node node;
+            node.position = t_position;
+            node.parentPosition = t_nodes.empty() ? t_position : t_nodes.back().position;
+            node.g = t_nodes.empty() ? 0.0f : t_nodes.back().g + 1.0f;
+            node.f = node.g;
+
+            t_nodes.push_back(node);
+        }
+    };
+}
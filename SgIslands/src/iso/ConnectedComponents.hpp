@@ -0,0 +1,438 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: ConnectedComponents.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+#include "ChunkedGrid.hpp"
+#include "IsoMath.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief Labels the 8-connected regions of walkable cells.
+     *        Two cells with the same label can reach each other, so a pathfinding request
+     *        between different labels can be rejected without a search.
+     *        The walkability is passed as callable `bool(int x, int y)`.
+     *        The labels are kept in a `ChunkedGrid`, so a copy of them is cheap.
+     */
+    class ConnectedComponents
+    {
+    public:
+        using Label = int;
+
+        static constexpr Label NO_COMPONENT{ -1 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        ConnectedComponents() = default;
+
+        ConnectedComponents(const ConnectedComponents& t_other) = delete;
+        ConnectedComponents(ConnectedComponents&& t_other) noexcept = delete;
+        ConnectedComponents& operator=(const ConnectedComponents& t_other) = delete;
+        ConnectedComponents& operator=(ConnectedComponents&& t_other) noexcept = delete;
+
+        ~ConnectedComponents() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Returns the label of a cell or `NO_COMPONENT` for a blocked cell.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @return Label
+         */
+        Label GetLabel(const int t_mapX, const int t_mapY) const
+        {
+            return m_labels.Get(t_mapX, t_mapY);
+        }
+
+        /**
+         * @brief Returns the label per cell.
+         * @return Const reference to `ChunkedGrid`
+         */
+        const ChunkedGrid<Label>& GetLabels() const noexcept { return m_labels; }
+
+        /**
+         * @brief Checks if two cells are in the same region.
+         * @param t_fromX The x-map position of the first cell.
+         * @param t_fromY The y-map position of the first cell.
+         * @param t_toX The x-map position of the second cell.
+         * @param t_toY The y-map position of the second cell.
+         * @return bool
+         */
+        bool IsConnected(const int t_fromX, const int t_fromY, const int t_toX, const int t_toY) const
+        {
+            const auto label{ GetLabel(t_fromX, t_fromY) };
+
+            return label != NO_COMPONENT && label == GetLabel(t_toX, t_toY);
+        }
+
+        /**
+         * @brief Returns the number of regions.
+         * @return std::size_t
+         */
+        std::size_t GetNumberOfComponents() const noexcept
+        {
+            return m_sizes.size() - m_freeLabels.size();
+        }
+
+        //-------------------------------------------------
+        // Build
+        //-------------------------------------------------
+
+        /**
+         * @brief Labels all cells from scratch.
+         * @tparam TWalkable Callable `bool(int, int)`.
+         * @param t_width The map width.
+         * @param t_height The map height.
+         * @param t_isWalkable Checks if a cell can be entered.
+         */
+        template <typename TWalkable>
+        void Build(const int t_width, const int t_height, TWalkable t_isWalkable)
+        {
+            m_width = t_width;
+            m_height = t_height;
+
+            m_labels.Assign(m_width, m_height, NO_COMPONENT);
+            m_sizes.clear();
+            m_freeLabels.clear();
+
+            for (auto y{ 0 }; y < m_height; ++y)
+            {
+                for (auto x{ 0 }; x < m_width; ++x)
+                {
+                    if (t_isWalkable(x, y) && GetLabel(x, y) == NO_COMPONENT)
+                    {
+                        const auto label{ NewLabel() };
+                        m_sizes[label] = Fill(x, y, NO_COMPONENT, label, t_isWalkable);
+                    }
+                }
+            }
+
+            // the chunks of the open sea or inside an island share one chunk again
+            m_labels.Compact();
+        }
+
+        //-------------------------------------------------
+        // Update
+        //-------------------------------------------------
+
+        /**
+         * @brief Updates the labels after the walkability of one cell has changed.
+         *        Only the regions around the cell are touched.
+         * @tparam TWalkable Callable `bool(int, int)`.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_isWalkable Checks if a cell can be entered.
+         */
+        template <typename TWalkable>
+        void Update(const int t_mapX, const int t_mapY, TWalkable t_isWalkable)
+        {
+            const auto walkable{ t_isWalkable(t_mapX, t_mapY) };
+            const auto labeled{ GetLabel(t_mapX, t_mapY) != NO_COMPONENT };
+
+            if (walkable == labeled)
+            {
+                return;
+            }
+
+            if (walkable)
+            {
+                AddCell(t_mapX, t_mapY, t_isWalkable);
+            }
+            else
+            {
+                RemoveCell(t_mapX, t_mapY, t_isWalkable);
+            }
+        }
+
+    protected:
+
+    private:
+        /**
+         * @brief The map width.
+         */
+        int m_width{ 0 };
+
+        /**
+         * @brief The map height.
+         */
+        int m_height{ 0 };
+
+        /**
+         * @brief The label per cell.
+         */
+        ChunkedGrid<Label> m_labels;
+
+        /**
+         * @brief The number of cells per label.
+         */
+        std::vector<int> m_sizes;
+
+        /**
+         * @brief Labels of merged regions for reuse.
+         */
+        std::vector<Label> m_freeLabels;
+
+        /**
+         * @brief Queue for the flood fill; kept to avoid allocations.
+         */
+        std::vector<int> m_queue;
+
+        //-------------------------------------------------
+        // Labels
+        //-------------------------------------------------
+
+        Label NewLabel()
+        {
+            if (!m_freeLabels.empty())
+            {
+                const auto label{ m_freeLabels.back() };
+                m_freeLabels.pop_back();
+                m_sizes[label] = 0;
+
+                return label;
+            }
+
+            m_sizes.push_back(0);
+
+            return static_cast<Label>(m_sizes.size() - 1);
+        }
+
+        void FreeLabel(const Label t_label)
+        {
+            m_sizes[t_label] = 0;
+            m_freeLabels.push_back(t_label);
+        }
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        bool IsInside(const int t_mapX, const int t_mapY) const
+        {
+            return t_mapX >= 0 && t_mapY >= 0 && t_mapX < m_width && t_mapY < m_height;
+        }
+
+        /**
+         * @brief Replaces `t_from` by `t_to` in the walkable region around a cell.
+         * @return int The number of relabeled cells.
+         */
+        template <typename TWalkable>
+        int Fill(const int t_mapX, const int t_mapY, const Label t_from, const Label t_to, TWalkable& t_isWalkable)
+        {
+            auto count{ 0 };
+
+            m_queue.clear();
+            m_queue.push_back(IsoMath::From2DTo1D(t_mapX, t_mapY, m_width));
+            m_labels.Set(t_mapX, t_mapY, t_to);
+
+            for (std::size_t i{ 0 }; i < m_queue.size(); ++i)
+            {
+                const auto index{ m_queue[i] };
+                const auto x{ index % m_width };
+                const auto y{ index / m_width };
+
+                count++;
+
+                for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+                {
+                    for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                    {
+                        const auto nx{ x + xOffset };
+                        const auto ny{ y + yOffset };
+
+                        if (!IsInside(nx, ny))
+                        {
+                            continue;
+                        }
+
+                        if (m_labels.Get(nx, ny) == t_from && t_isWalkable(nx, ny))
+                        {
+                            m_labels.Set(nx, ny, t_to);
+                            m_queue.push_back(IsoMath::From2DTo1D(nx, ny, m_width));
+                        }
+                    }
+                }
+            }
+
+            return count;
+        }
+
+        /**
+         * @brief A blocked cell becomes walkable: join it with the neighbours and merge their regions.
+         *        The smaller regions are relabeled to the largest one.
+         */
+        template <typename TWalkable>
+        void AddCell(const int t_mapX, const int t_mapY, TWalkable& t_isWalkable)
+        {
+            std::array<int, 8> positions{};
+            std::array<Label, 8> labels{};
+            auto count{ 0 };
+            auto largest{ NO_COMPONENT };
+
+            for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+            {
+                for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                {
+                    const auto nx{ t_mapX + xOffset };
+                    const auto ny{ t_mapY + yOffset };
+
+                    if ((xOffset == 0 && yOffset == 0) || !IsInside(nx, ny))
+                    {
+                        continue;
+                    }
+
+                    const auto label{ GetLabel(nx, ny) };
+                    if (label == NO_COMPONENT)
+                    {
+                        continue;
+                    }
+
+                    positions[count] = IsoMath::From2DTo1D(nx, ny, m_width);
+                    labels[count] = label;
+                    count++;
+
+                    if (largest == NO_COMPONENT || m_sizes[label] > m_sizes[largest])
+                    {
+                        largest = label;
+                    }
+                }
+            }
+
+            if (largest == NO_COMPONENT)
+            {
+                largest = NewLabel();
+            }
+
+            m_labels.Set(t_mapX, t_mapY, largest);
+            m_sizes[largest]++;
+
+            for (auto i{ 0 }; i < count; ++i)
+            {
+                const auto label{ m_labels.Get(positions[i] % m_width, positions[i] / m_width) };
+                if (label != largest)
+                {
+                    assert(label == labels[i]);
+
+                    m_sizes[largest] += Fill(positions[i] % m_width, positions[i] / m_width, label, largest, t_isWalkable);
+                    FreeLabel(label);
+                }
+            }
+        }
+
+        /**
+         * @brief A walkable cell becomes blocked. If the remaining neighbours are not connected
+         *        around the cell, the region may be split and the parts get new labels.
+         */
+        template <typename TWalkable>
+        void RemoveCell(const int t_mapX, const int t_mapY, TWalkable& t_isWalkable)
+        {
+            const auto label{ GetLabel(t_mapX, t_mapY) };
+
+            m_labels.Set(t_mapX, t_mapY, NO_COMPONENT);
+            m_sizes[label]--;
+
+            // collect the neighbours of the same region
+            std::array<sf::Vector2i, 8> neighbours{};
+            auto count{ 0 };
+
+            for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+            {
+                for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                {
+                    const auto nx{ t_mapX + xOffset };
+                    const auto ny{ t_mapY + yOffset };
+
+                    if ((xOffset != 0 || yOffset != 0) && IsInside(nx, ny) && GetLabel(nx, ny) == label)
+                    {
+                        neighbours[count++] = sf::Vector2i(nx, ny);
+                    }
+                }
+            }
+
+            if (count == 0)
+            {
+                FreeLabel(label);
+                return;
+            }
+
+            // group the neighbours that touch each other
+            std::array<int, 8> groups{};
+            for (auto i{ 0 }; i < count; ++i)
+            {
+                groups[i] = i;
+            }
+
+            for (auto i{ 0 }; i < count; ++i)
+            {
+                for (auto j{ i + 1 }; j < count; ++j)
+                {
+                    if (std::abs(neighbours[i].x - neighbours[j].x) <= 1 && std::abs(neighbours[i].y - neighbours[j].y) <= 1)
+                    {
+                        const auto from{ groups[j] };
+                        const auto to{ groups[i] };
+                        for (auto k{ 0 }; k < count; ++k)
+                        {
+                            if (groups[k] == from)
+                            {
+                                groups[k] = to;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // still connected around the removed cell
+            auto split{ false };
+            for (auto i{ 1 }; i < count; ++i)
+            {
+                if (groups[i] != groups[0])
+                {
+                    split = true;
+                }
+            }
+
+            if (!split)
+            {
+                return;
+            }
+
+            // the groups may still be connected somewhere else: relabel every group except the
+            // first one; a group that reaches the first group takes over the whole region
+            for (auto i{ 1 }; i < count; ++i)
+            {
+                if (GetLabel(neighbours[i].x, neighbours[i].y) != label)
+                {
+                    continue;
+                }
+
+                const auto newLabel{ NewLabel() };
+                m_sizes[newLabel] = Fill(neighbours[i].x, neighbours[i].y, label, newLabel, t_isWalkable);
+                m_sizes[label] -= m_sizes[newLabel];
+            }
+
+            if (m_sizes[label] == 0)
+            {
+                FreeLabel(label);
+            }
+        }
+    };
+}
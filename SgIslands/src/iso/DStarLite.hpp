@@ -0,0 +1,401 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: DStarLite.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Map.hpp"
+#include "Node.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief An incremental planner (D* Lite) for one moving unit.
+     *        The search runs backwards from the target, so the costs to the target stay valid while
+     *        the unit moves. When map fields change, only the costs that depend on them are repaired.
+     *        The costs are the same as in the A* search: one per step, corner cutting is allowed.
+     */
+    class DStarLite
+    {
+    public:
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        DStarLite() = delete;
+
+        /**
+         * @brief Creates the planner. Call `ComputePath()` to get the first path.
+         * @param t_map The `Map` with the walkability.
+         * @param t_startPosition The map position of the unit.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         */
+        DStarLite(
+            const Map& t_map,
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType t_assetType,
+            const int t_footprint = 1
+        )
+            : m_map{ t_map }
+            , m_assetType{ t_assetType }
+            , m_footprint{ t_footprint }
+            , m_startPosition{ t_startPosition }
+            , m_lastStartPosition{ t_startPosition }
+            , m_targetPosition{ t_targetPosition }
+        {
+            const auto targetIndex{ ToIndex(m_targetPosition) };
+
+            m_cells[targetIndex].rhs = 0.0f;
+            Insert(targetIndex, CalculateKey(targetIndex));
+        }
+
+        DStarLite(const DStarLite& t_other) = delete;
+        DStarLite(DStarLite&& t_other) noexcept = delete;
+        DStarLite& operator=(const DStarLite& t_other) = delete;
+        DStarLite& operator=(DStarLite&& t_other) noexcept = delete;
+
+        ~DStarLite() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        const auto& GetTargetPosition() const noexcept { return m_targetPosition; }
+
+        auto GetAssetType() const noexcept { return m_assetType; }
+
+        auto GetFootprint() const noexcept { return m_footprint; }
+
+        /**
+         * @brief Returns the number of nodes taken from the queue since the planner was created.
+         * @return std::size_t
+         */
+        std::size_t GetExpandedNodes() const noexcept { return m_expandedNodes; }
+
+        //-------------------------------------------------
+        // Planning
+        //-------------------------------------------------
+
+        /**
+         * @brief Finds the path from the current start to the target.
+         * @param t_path Receives the path; the first node is the start.
+         * @return bool False if the target cannot be reached or is already reached.
+         */
+        bool ComputePath(std::vector<Node>& t_path)
+        {
+            t_path.clear();
+
+            if (m_startPosition == m_targetPosition)
+            {
+                return false;
+            }
+
+            // the regions are known, so there is no need to search a whole region in vain
+            if (!m_map.IsReachable(m_startPosition, m_targetPosition, m_assetType))
+            {
+                return false;
+            }
+
+            ComputeShortestPath();
+
+            return MakePath(t_path);
+        }
+
+        /**
+         * @brief Repairs the path after map fields have changed.
+         * @param t_startPosition The map position the unit has reached.
+         * @param t_changedPositions The changed map fields.
+         * @param t_path Receives the repaired path; the first node is the start.
+         * @return bool False if the target cannot be reached anymore.
+         */
+        bool Replan(const sf::Vector2i& t_startPosition, const std::vector<sf::Vector2i>& t_changedPositions, std::vector<Node>& t_path)
+        {
+            // the keys in the queue are based on the old start; instead of updating them all, km grows
+            m_startPosition = t_startPosition;
+            m_km += Heuristic(m_lastStartPosition, m_startPosition);
+            m_lastStartPosition = m_startPosition;
+
+            // a changed map field changes the walkability of all footprints on it and so the
+            // costs of all edges to and from these positions
+            for (const auto& position : t_changedPositions)
+            {
+                for (auto y{ position.y - m_footprint }; y <= position.y + m_footprint; ++y)
+                {
+                    for (auto x{ position.x - m_footprint }; x <= position.x + m_footprint; ++x)
+                    {
+                        UpdateVertex({ x, y });
+                    }
+                }
+            }
+
+            return ComputePath(t_path);
+        }
+
+    protected:
+
+    private:
+        using CellIndex = int;
+        using Key = std::pair<float, float>;
+
+        static constexpr auto INF{ std::numeric_limits<float>::infinity() };
+
+        static constexpr std::array<int, 8> DIRECTION_X{ 0, 1, 0, -1, 1, 1, -1, -1 };
+        static constexpr std::array<int, 8> DIRECTION_Y{ -1, 0, 1, 0, -1, 1, 1, -1 };
+
+        struct Cell
+        {
+            float g{ INF };
+            float rhs{ INF };
+        };
+
+        const Map& m_map;
+        AssetType m_assetType;
+        int m_footprint{ 1 };
+
+        sf::Vector2i m_startPosition;
+        sf::Vector2i m_lastStartPosition;
+        sf::Vector2i m_targetPosition;
+
+        /**
+         * @brief The key modifier; sum of the heuristic distances the start has moved.
+         */
+        float m_km{ 0.0f };
+
+        /**
+         * @brief Only the visited cells are stored, so an idle planner is cheap.
+         */
+        std::unordered_map<CellIndex, Cell> m_cells;
+
+        /**
+         * @brief The priority queue and the key of each cell in it.
+         */
+        std::set<std::pair<Key, CellIndex>> m_queue;
+        std::unordered_map<CellIndex, Key> m_queuedKeys;
+
+        std::size_t m_expandedNodes{ 0 };
+
+        //-------------------------------------------------
+        // D* Lite
+        //-------------------------------------------------
+
+        void ComputeShortestPath()
+        {
+            const auto startIndex{ ToIndex(m_startPosition) };
+
+            while (!m_queue.empty() &&
+                (m_queue.begin()->first < CalculateKey(startIndex) || GetCell(startIndex).rhs != GetCell(startIndex).g))
+            {
+                const auto [oldKey, index] { *m_queue.begin() };
+                const auto newKey{ CalculateKey(index) };
+
+                m_expandedNodes++;
+
+                if (oldKey < newKey)
+                {
+                    Remove(index);
+                    Insert(index, newKey);
+
+                    continue;
+                }
+
+                auto& cell{ m_cells[index] };
+                const auto position{ ToPosition(index) };
+
+                Remove(index);
+
+                if (cell.g > cell.rhs)
+                {
+                    cell.g = cell.rhs;
+                }
+                else
+                {
+                    cell.g = INF;
+                    UpdateVertex(position);
+                }
+
+                for (std::size_t i{ 0 }; i < DIRECTION_X.size(); ++i)
+                {
+                    UpdateVertex({ position.x + DIRECTION_X[i], position.y + DIRECTION_Y[i] });
+                }
+            }
+        }
+
+        void UpdateVertex(const sf::Vector2i& t_position)
+        {
+            if (!IsInside(t_position))
+            {
+                return;
+            }
+
+            const auto index{ ToIndex(t_position) };
+
+            if (t_position != m_targetPosition)
+            {
+                auto rhs{ INF };
+
+                for (std::size_t i{ 0 }; i < DIRECTION_X.size(); ++i)
+                {
+                    const sf::Vector2i neighbour{ t_position.x + DIRECTION_X[i], t_position.y + DIRECTION_Y[i] };
+                    rhs = std::min(rhs, Cost(t_position, neighbour) + GetCell(ToIndex(neighbour)).g);
+                }
+
+                // avoid to store untouched cells
+                if (rhs == INF && m_cells.find(index) == m_cells.end())
+                {
+                    return;
+                }
+
+                m_cells[index].rhs = rhs;
+            }
+
+            Remove(index);
+
+            const auto& cell{ GetCell(index) };
+            if (cell.g != cell.rhs)
+            {
+                Insert(index, CalculateKey(index));
+            }
+        }
+
+        Key CalculateKey(const CellIndex t_index) const
+        {
+            const auto& cell{ GetCell(t_index) };
+            const auto minCost{ std::min(cell.g, cell.rhs) };
+
+            return { minCost + Heuristic(m_startPosition, ToPosition(t_index)) + m_km, minCost };
+        }
+
+        //-------------------------------------------------
+        // Path
+        //-------------------------------------------------
+
+        bool MakePath(std::vector<Node>& t_path) const
+        {
+            if (GetCell(ToIndex(m_startPosition)).g == INF)
+            {
+                return false;
+            }
+
+            auto position{ m_startPosition };
+
+            Node node;
+            node.position = position;
+            t_path.push_back(node);
+
+            // g strictly decreases along the path, this is only a guard
+            const auto maxLength{ static_cast<std::size_t>(m_map.GetMapWidth() * m_map.GetMapHeight()) };
+
+            while (position != m_targetPosition)
+            {
+                auto bestCost{ INF };
+                auto bestPosition{ position };
+
+                for (std::size_t i{ 0 }; i < DIRECTION_X.size(); ++i)
+                {
+                    const sf::Vector2i neighbour{ position.x + DIRECTION_X[i], position.y + DIRECTION_Y[i] };
+                    const auto cost{ Cost(position, neighbour) + GetCell(ToIndex(neighbour)).g };
+
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestPosition = neighbour;
+                    }
+                }
+
+                if (bestCost == INF || t_path.size() > maxLength)
+                {
+                    t_path.clear();
+                    return false;
+                }
+
+                position = bestPosition;
+                node.parentPosition = node.position;
+                node.position = position;
+                t_path.push_back(node);
+            }
+
+            return true;
+        }
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        float Cost(const sf::Vector2i& t_from, const sf::Vector2i& t_to) const
+        {
+            if (!m_map.IsWalkable(t_from.x, t_from.y, m_assetType, m_footprint) || !m_map.IsWalkable(t_to.x, t_to.y, m_assetType, m_footprint))
+            {
+                return INF;
+            }
+
+            return 1.0f;
+        }
+
+        /**
+         * @brief The Chebyshev distance; it never overestimates a path with a cost of one per step.
+         */
+        static float Heuristic(const sf::Vector2i& t_from, const sf::Vector2i& t_to)
+        {
+            return static_cast<float>(std::max(std::abs(t_from.x - t_to.x), std::abs(t_from.y - t_to.y)));
+        }
+
+        const Cell& GetCell(const CellIndex t_index) const
+        {
+            static const Cell unvisited;
+
+            const auto it{ m_cells.find(t_index) };
+
+            return it == m_cells.end() ? unvisited : it->second;
+        }
+
+        void Insert(const CellIndex t_index, const Key& t_key)
+        {
+            m_queue.emplace(t_key, t_index);
+            m_queuedKeys[t_index] = t_key;
+        }
+
+        void Remove(const CellIndex t_index)
+        {
+            const auto it{ m_queuedKeys.find(t_index) };
+
+            if (it != m_queuedKeys.end())
+            {
+                m_queue.erase({ it->second, t_index });
+                m_queuedKeys.erase(it);
+            }
+        }
+
+        bool IsInside(const sf::Vector2i& t_position) const
+        {
+            return t_position.x >= 0 && t_position.y >= 0 && t_position.x < m_map.GetMapWidth() && t_position.y < m_map.GetMapHeight();
+        }
+
+        CellIndex ToIndex(const sf::Vector2i& t_position) const
+        {
+            return IsoMath::From2DTo1D(t_position.x, t_position.y, m_map.GetMapWidth());
+        }
+
+        sf::Vector2i ToPosition(const CellIndex t_index) const
+        {
+            return { t_index % m_map.GetMapWidth(), t_index / m_map.GetMapWidth() };
+        }
+    };
+}
@@ -0,0 +1,188 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: DeepWater.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/Time.hpp>
+#include "TileAtlas.hpp"
+#include "IsoMath.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief The deep water background of a `Map` as one quad with a repeated texture.
+     *        The deep water tiles form a grid that repeats every 640 x 320 pixels, so the
+     *        texture is this rectangle filled with the deep water tile and its neighbours.
+     *        The water moves by shifting the texture coordinates of the quad.
+     */
+    class DeepWater
+    {
+    public:
+        /**
+         * @brief The distance in pixels the water moves each second; still water as before by default.
+         */
+        inline static const sf::Vector2f DEFAULT_FLOW{ 0.0f, 0.0f };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        DeepWater() = default;
+
+        DeepWater(const DeepWater& t_other) = delete;
+        DeepWater(DeepWater&& t_other) noexcept = delete;
+        DeepWater& operator=(const DeepWater& t_other) = delete;
+        DeepWater& operator=(DeepWater&& t_other) noexcept = delete;
+
+        ~DeepWater() noexcept = default;
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * @brief Set the size of the water; the texture is created with the first draw.
+         * @param t_deepWaterWidth The map width in deep water tiles.
+         * @param t_deepWaterHeight The map height in deep water tiles.
+         */
+        void Resize(const int t_deepWaterWidth, const int t_deepWaterHeight)
+        {
+            m_deepWaterWidth = t_deepWaterWidth;
+            m_deepWaterHeight = t_deepWaterHeight;
+        }
+
+        /**
+         * @brief Set the distance in pixels the water moves each second.
+         * @param t_flow The flow; zero stops the water.
+         */
+        void SetFlow(const sf::Vector2f& t_flow) { m_flow = t_flow; }
+
+        //-------------------------------------------------
+        // Update
+        //-------------------------------------------------
+
+        void Update(const sf::Time& t_dt)
+        {
+            // keep the offset within one texture, so the texture coordinates stay small
+            m_offset.x = std::fmod(m_offset.x + m_flow.x * t_dt.asSeconds(), static_cast<float>(IsoMath::DEEP_WATER_TILE_WIDTH));
+            m_offset.y = std::fmod(m_offset.y + m_flow.y * t_dt.asSeconds(), static_cast<float>(IsoMath::DEEP_WATER_TILE_HEIGHT));
+        }
+
+        //-------------------------------------------------
+        // Draw
+        //-------------------------------------------------
+
+        /**
+         * @brief Draws the water with one call.
+         * @param t_target The target to draw on.
+         * @param t_tileAtlas The atlas with the deep water tile.
+         */
+        void Draw(sf::RenderTarget& t_target, const TileAtlas& t_tileAtlas)
+        {
+            if (!m_renderTexture)
+            {
+                CreateTexture(t_tileAtlas);
+                CreateQuad();
+            }
+
+            // the texture coordinates follow the screen positions, shifted by the flow
+            for (std::size_t i{ 0 }; i < m_quad.getVertexCount(); ++i)
+            {
+                m_quad[i].texCoords = m_quad[i].position - GetOrigin() - m_offset;
+            }
+
+            sf::RenderStates states;
+            states.texture = &m_renderTexture->getTexture();
+
+            t_target.draw(m_quad, states);
+        }
+
+    protected:
+
+    private:
+        int m_deepWaterWidth{ 0 };
+        int m_deepWaterHeight{ 0 };
+
+        sf::Vector2f m_flow{ DEFAULT_FLOW };
+        sf::Vector2f m_offset;
+
+        /**
+         * @brief The repeated texture.
+         */
+        std::unique_ptr<sf::RenderTexture> m_renderTexture;
+
+        /**
+         * @brief The map area.
+         */
+        sf::VertexArray m_quad{ sf::Quads, 4 };
+
+        /**
+         * @brief The screen position of the top left corner of the first deep water tile.
+         */
+        static sf::Vector2f GetOrigin()
+        {
+            return sf::Vector2f(-IsoMath::DEEP_WATER_TILE_WIDTH_HALF, static_cast<float>(IsoMath::DEFAULT_TILE_HEIGHT));
+        }
+
+        /**
+         * @brief Draws the tile into the texture with the four neighbours that fill its corners.
+         */
+        void CreateTexture(const TileAtlas& t_tileAtlas)
+        {
+            const auto& deepWaterSouth{ t_tileAtlas.GetBackgroundTile(TileAtlas::DEEP_WATER_SOUTH_TILE) };
+
+            m_renderTexture = std::make_unique<sf::RenderTexture>();
+            if (!m_renderTexture->create(IsoMath::DEEP_WATER_TILE_WIDTH, IsoMath::DEEP_WATER_TILE_HEIGHT))
+            {
+                THROW_SG_EXCEPTION("[DeepWater::CreateTexture()] Failed to create the deep water texture.");
+            }
+
+            m_renderTexture->clear(sf::Color::Transparent);
+
+            sf::Sprite sprite{ t_tileAtlas.GetTexture(deepWaterSouth.page), deepWaterSouth.rect };
+
+            const auto w{ IsoMath::DEEP_WATER_TILE_WIDTH_HALF };
+            const auto h{ IsoMath::DEEP_WATER_TILE_HEIGHT_HALF };
+
+            for (const auto& position : { sf::Vector2f(0.0f, 0.0f), sf::Vector2f(-w, -h), sf::Vector2f(w, -h), sf::Vector2f(-w, h), sf::Vector2f(w, h) })
+            {
+                sprite.setPosition(position);
+                m_renderTexture->draw(sprite);
+            }
+
+            m_renderTexture->display();
+            m_renderTexture->setRepeated(true);
+        }
+
+        /**
+         * @brief Creates the diamond that the deep water tiles of the map cover.
+         */
+        void CreateQuad()
+        {
+            const auto w{ IsoMath::DEEP_WATER_TILE_WIDTH_HALF };
+            const auto h{ IsoMath::DEEP_WATER_TILE_HEIGHT_HALF };
+            const auto width{ static_cast<float>(m_deepWaterWidth) };
+            const auto height{ static_cast<float>(m_deepWaterHeight) };
+            const auto origin{ GetOrigin() };
+
+            // top, right, bottom and left corner
+            m_quad[0].position = sf::Vector2f(origin.x + w, origin.y);
+            m_quad[1].position = sf::Vector2f(origin.x + w + width * w, origin.y + width * h);
+            m_quad[2].position = sf::Vector2f(origin.x + w + (width - height) * w, origin.y + (width + height) * h);
+            m_quad[3].position = sf::Vector2f(origin.x + w - height * w, origin.y + height * h);
+        }
+    };
+}
@@ -0,0 +1,224 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: FlowField.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Map.hpp"
+#include "OpenList.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief Stores for each map field the direction to the next map field on a shortest way to one target.
+     *        The field is generated with a single Dijkstra pass that starts at the target, so any number
+     *        of units with the same target and `AssetType` can follow it.
+     */
+    class FlowField
+    {
+    public:
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        FlowField() = delete;
+
+        /**
+         * @brief Generates the field.
+         * @param t_map The `Map` with the walkability.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the units (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the units in map fields.
+         * @param t_openList A reusable open list which is sized to the `Map`.
+         */
+        FlowField(const Map& t_map, const sf::Vector2i& t_targetPosition, const AssetType t_assetType, const int t_footprint, OpenList& t_openList)
+            : m_mapWidth{ t_map.GetMapWidth() }
+            , m_mapHeight{ t_map.GetMapHeight() }
+            , m_version{ t_map.GetVersion() }
+            , m_targetPosition{ t_targetPosition }
+            , m_assetType{ t_assetType }
+            , m_footprint{ t_footprint }
+        {
+            Generate(t_map, t_openList);
+        }
+
+        FlowField(const FlowField& t_other) = delete;
+        FlowField(FlowField&& t_other) noexcept = delete;
+        FlowField& operator=(const FlowField& t_other) = delete;
+        FlowField& operator=(FlowField&& t_other) noexcept = delete;
+
+        ~FlowField() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        const auto& GetTargetPosition() const noexcept { return m_targetPosition; }
+
+        auto GetAssetType() const noexcept { return m_assetType; }
+
+        auto GetFootprint() const noexcept { return m_footprint; }
+
+        /**
+         * @brief Get the `Map` version from which the field was generated.
+         * @return std::uint32_t
+         */
+        auto GetVersion() const noexcept { return m_version; }
+
+        /**
+         * @brief Checks if the target can be reached from a map position.
+         * @param t_mapPosition The map position.
+         * @return bool
+         */
+        bool HasNextPosition(const sf::Vector2i& t_mapPosition) const
+        {
+            return GetDirection(t_mapPosition) != NO_DIRECTION;
+        }
+
+        /**
+         * @brief Get the map position to go next.
+         * @param t_mapPosition The current map position. Must have a next position.
+         * @return sf::Vector2i
+         */
+        sf::Vector2i GetNextPosition(const sf::Vector2i& t_mapPosition) const
+        {
+            const auto direction{ GetDirection(t_mapPosition) };
+            assert(direction != NO_DIRECTION);
+
+            return { t_mapPosition.x + DIRECTION_X[direction], t_mapPosition.y + DIRECTION_Y[direction] };
+        }
+
+    protected:
+
+    private:
+        static constexpr std::int8_t NO_DIRECTION{ -1 };
+
+        /**
+         * @brief The straight directions come first, so they win ties.
+         */
+        static constexpr std::array<int, 8> DIRECTION_X{ 0, 1, 0, -1, 1, 1, -1, -1 };
+        static constexpr std::array<int, 8> DIRECTION_Y{ -1, 0, 1, 0, -1, 1, 1, -1 };
+
+        static constexpr float STRAIGHT_COST{ 1.0f };
+        static constexpr float DIAGONAL_COST{ 1.41421356f };
+
+        int m_mapWidth{ 0 };
+        int m_mapHeight{ 0 };
+        std::uint32_t m_version{ 0 };
+        sf::Vector2i m_targetPosition;
+        AssetType m_assetType;
+        int m_footprint{ 1 };
+
+        /**
+         * @brief An index into `DIRECTION_X` and `DIRECTION_Y` for each map field or `NO_DIRECTION`.
+         */
+        std::vector<std::int8_t> m_directions;
+
+        //-------------------------------------------------
+        // Generate
+        //-------------------------------------------------
+
+        void Generate(const Map& t_map, OpenList& t_openList)
+        {
+            const auto numberOfCells{ static_cast<std::size_t>(m_mapWidth * m_mapHeight) };
+
+            m_directions.assign(numberOfCells, NO_DIRECTION);
+
+            if (!t_map.IsWalkable(m_targetPosition.x, m_targetPosition.y, m_assetType, m_footprint))
+            {
+                return;
+            }
+
+            // the costs from each map field to the target
+            std::vector<float> costs(numberOfCells, std::numeric_limits<float>::max());
+
+            const auto targetIndex{ IsoMath::From2DTo1D(m_targetPosition.x, m_targetPosition.y, m_mapWidth) };
+            costs[targetIndex] = 0.0f;
+
+            assert(t_openList.IsEmpty());
+            t_openList.Push(targetIndex, 0.0f);
+
+            while (!t_openList.IsEmpty())
+            {
+                const auto index{ t_openList.Pop() };
+                const auto x{ index % m_mapWidth };
+                const auto y{ index / m_mapWidth };
+
+                for (std::size_t i{ 0 }; i < DIRECTION_X.size(); ++i)
+                {
+                    const auto neighbourX{ x + DIRECTION_X[i] };
+                    const auto neighbourY{ y + DIRECTION_Y[i] };
+
+                    if (!t_map.IsWalkable(neighbourX, neighbourY, m_assetType, m_footprint))
+                    {
+                        continue;
+                    }
+
+                    const auto neighbourIndex{ IsoMath::From2DTo1D(neighbourX, neighbourY, m_mapWidth) };
+                    const auto cost{ costs[index] + (i < 4 ? STRAIGHT_COST : DIAGONAL_COST) };
+
+                    if (cost < costs[neighbourIndex])
+                    {
+                        costs[neighbourIndex] = cost;
+                        t_openList.Push(neighbourIndex, cost);
+                    }
+                }
+            }
+
+            // each reached map field points to the neighbour on its cheapest way
+            for (auto y{ 0 }; y < m_mapHeight; ++y)
+            {
+                for (auto x{ 0 }; x < m_mapWidth; ++x)
+                {
+                    const auto index{ IsoMath::From2DTo1D(x, y, m_mapWidth) };
+
+                    if (index == targetIndex || costs[index] == std::numeric_limits<float>::max())
+                    {
+                        continue;
+                    }
+
+                    auto bestCost{ std::numeric_limits<float>::max() };
+
+                    for (std::size_t i{ 0 }; i < DIRECTION_X.size(); ++i)
+                    {
+                        const auto neighbourX{ x + DIRECTION_X[i] };
+                        const auto neighbourY{ y + DIRECTION_Y[i] };
+
+                        if (!t_map.IsWalkable(neighbourX, neighbourY, m_assetType, m_footprint))
+                        {
+                            continue;
+                        }
+
+                        const auto cost{ costs[IsoMath::From2DTo1D(neighbourX, neighbourY, m_mapWidth)] + (i < 4 ? STRAIGHT_COST : DIAGONAL_COST) };
+                        if (cost < bestCost)
+                        {
+                            bestCost = cost;
+                            m_directions[index] = static_cast<std::int8_t>(i);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::int8_t GetDirection(const sf::Vector2i& t_mapPosition) const
+        {
+            if (t_mapPosition.x < 0 || t_mapPosition.y < 0 || t_mapPosition.x >= m_mapWidth || t_mapPosition.y >= m_mapHeight)
+            {
+                return NO_DIRECTION;
+            }
+
+            return m_directions[IsoMath::From2DTo1D(t_mapPosition.x, t_mapPosition.y, m_mapWidth)];
+        }
+    };
+}
@@ -0,0 +1,198 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: FlowFieldCache.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "FlowField.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief Shares one `FlowField` between all units with the same target, `AssetType` and footprint.
+     *        The cached fields are dropped when the walkability of the `Map` changes; the units keep
+     *        following their field until `Refresh()` finds the way blocked.
+     */
+    class FlowFieldCache
+    {
+    public:
+        using FlowFieldSharedPtr = std::shared_ptr<const FlowField>;
+
+        /**
+         * @brief Fields that no unit follows anymore are removed when the cache grows beyond this size.
+         */
+        static constexpr std::size_t MAX_CACHED_FIELDS{ 16 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        FlowFieldCache() = delete;
+
+        explicit FlowFieldCache(const Map& t_map)
+            : m_map{ t_map }
+            , m_version{ t_map.GetVersion() }
+        {
+            m_openList.Resize(m_map.GetMapWidth(), m_map.GetMapHeight());
+        }
+
+        FlowFieldCache(const FlowFieldCache& t_other) = delete;
+        FlowFieldCache(FlowFieldCache&& t_other) noexcept = delete;
+        FlowFieldCache& operator=(const FlowFieldCache& t_other) = delete;
+        FlowFieldCache& operator=(FlowFieldCache&& t_other) noexcept = delete;
+
+        ~FlowFieldCache() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Get the number of generated fields.
+         * @return std::size_t
+         */
+        auto GetNumberOfGeneratedFields() const noexcept { return m_numberOfGeneratedFields; }
+
+        /**
+         * @brief Checks if a field was generated before the last change of the `Map`.
+         * @param t_flowField The field.
+         * @return bool
+         */
+        bool IsOutdated(const FlowField& t_flowField) const
+        {
+            return t_flowField.GetVersion() != m_map.GetVersion();
+        }
+
+        //-------------------------------------------------
+        // Flow fields
+        //-------------------------------------------------
+
+        /**
+         * @brief Get the field to a target. The field is only generated if it is not in the cache.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the units (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the units in map fields.
+         * @return FlowFieldSharedPtr or nullptr if the target cannot be entered.
+         */
+        FlowFieldSharedPtr Get(const sf::Vector2i& t_targetPosition, const AssetType t_assetType, const int t_footprint = 1)
+        {
+            if (!m_map.IsWalkable(t_targetPosition.x, t_targetPosition.y, t_assetType, t_footprint))
+            {
+                return nullptr;
+            }
+
+            if (m_version != m_map.GetVersion())
+            {
+                m_flowFields.clear();
+                m_version = m_map.GetVersion();
+            }
+
+            const auto key{ GetKey(t_targetPosition, t_assetType, t_footprint) };
+
+            const auto it{ m_flowFields.find(key) };
+            if (it != m_flowFields.end())
+            {
+                return it->second;
+            }
+
+            if (m_flowFields.size() >= MAX_CACHED_FIELDS)
+            {
+                RemoveUnusedFields();
+            }
+
+            auto flowField{ std::make_shared<const FlowField>(m_map, t_targetPosition, t_assetType, t_footprint, m_openList) };
+            m_flowFields.emplace(key, flowField);
+            m_numberOfGeneratedFields++;
+
+            SG_ISLANDS_DEBUG("[FlowFieldCache::Get()] Generated flow field to x: {}, y: {}.", t_targetPosition.x, t_targetPosition.y);
+
+            return flowField;
+        }
+
+        /**
+         * @brief Keeps a unit on its field after the `Map` has changed. An outdated field is followed as long as
+         *        its next map field can still be entered; only a blocked way leads to a new field.
+         * @param t_flowField The field the unit follows.
+         * @param t_mapPosition The map position of the unit.
+         * @return FlowFieldSharedPtr The field to follow or nullptr if the target cannot be entered.
+         */
+        FlowFieldSharedPtr Refresh(const FlowFieldSharedPtr& t_flowField, const sf::Vector2i& t_mapPosition)
+        {
+            assert(t_flowField);
+
+            if (!IsOutdated(*t_flowField))
+            {
+                return t_flowField;
+            }
+
+            if (t_flowField->HasNextPosition(t_mapPosition))
+            {
+                const auto nextPosition{ t_flowField->GetNextPosition(t_mapPosition) };
+
+                if (m_map.IsWalkable(nextPosition.x, nextPosition.y, t_flowField->GetAssetType(), t_flowField->GetFootprint()))
+                {
+                    return t_flowField;
+                }
+            }
+
+            return Get(t_flowField->GetTargetPosition(), t_flowField->GetAssetType(), t_flowField->GetFootprint());
+        }
+
+    protected:
+
+    private:
+        using Key = std::uint64_t;
+
+        /**
+         * @brief Reference to `Map`.
+         */
+        const Map& m_map;
+
+        /**
+         * @brief The `Map` version of the cached fields.
+         */
+        std::uint32_t m_version{ 0 };
+
+        std::unordered_map<Key, FlowFieldSharedPtr> m_flowFields;
+
+        /**
+         * @brief The open list is reused by each generation.
+         */
+        OpenList m_openList;
+
+        std::size_t m_numberOfGeneratedFields{ 0 };
+
+        Key GetKey(const sf::Vector2i& t_targetPosition, const AssetType t_assetType, const int t_footprint) const
+        {
+            const auto index{ static_cast<Key>(IsoMath::From2DTo1D(t_targetPosition.x, t_targetPosition.y, m_map.GetMapWidth())) };
+
+            return (index << 16) | (static_cast<Key>(t_footprint) << 8) | static_cast<Key>(t_assetType);
+        }
+
+        void RemoveUnusedFields()
+        {
+            for (auto it{ m_flowFields.begin() }; it != m_flowFields.end();)
+            {
+                // the cache holds the only reference
+                if (it->second.use_count() == 1)
+                {
+                    it = m_flowFields.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    };
+}
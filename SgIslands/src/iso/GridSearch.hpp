@@ -0,0 +1,1106 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: GridSearch.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "Node.hpp"
+#include "OpenList.hpp"
+#include "SearchArena.hpp"
+#include "IsoMath.hpp"
+#include "Asset.hpp"
+#include "LandmarkTable.hpp"
+
+namespace sg::islands::iso
+{
+    enum class SearchStatus
+    {
+        SEARCHING,
+        FOUND,
+        NOT_FOUND
+    };
+
+    /**
+     * @brief The grid searches that can be requested for a single query.
+     */
+    enum class SearchAlgorithm
+    {
+        ASTAR,
+        JPS,
+        BIDIRECTIONAL
+    };
+
+    /**
+     * @brief The grid searches (A* and Jump Point Search) with their reusable search state.
+     *        The grid is a template parameter, so the same code runs on the live `Map` in the
+     *        game thread and on a `WalkabilitySnapshot` in a worker thread.
+     *        `TGrid` needs `IsWalkable(x, y, assetType, footprint)`, `IsReachable(from, to, assetType)`
+     *        and `GetLandmarks(assetType)`, which may return nullptr.
+     *        A search can also be run in slices with `BeginSearch()` or `BeginBidirectionalSearch()`
+     *        and `ContinueSearch()`.
+     * @tparam TGrid `Map` or `WalkabilitySnapshot`.
+     */
+    template <typename TGrid>
+    class GridSearch
+    {
+    public:
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        GridSearch() = delete;
+
+        GridSearch(const int t_width, const int t_height)
+            : m_width{ t_width }
+            , m_height{ t_height }
+        {
+            m_arena.Resize(m_width, m_height);
+            m_openList.Resize(m_width, m_height);
+        }
+
+        GridSearch(const GridSearch& t_other) = delete;
+        GridSearch(GridSearch&& t_other) noexcept = delete;
+        GridSearch& operator=(const GridSearch& t_other) = delete;
+        GridSearch& operator=(GridSearch&& t_other) noexcept = delete;
+
+        ~GridSearch() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Returns the number of nodes taken from the open list in the last search.
+         * @return std::size_t
+         */
+        std::size_t GetExpandedNodes() const noexcept { return m_expandedNodes; }
+
+        /**
+         * @brief Returns the work of the last search: the expanded nodes and the map fields
+         *        walked over by the jumps of a Jump Point Search.
+         * @return std::size_t
+         */
+        std::size_t GetSearchCost() const noexcept { return m_expandedNodes + m_jumpedFields; }
+
+        //-------------------------------------------------
+        // A* Pathfinding
+        //-------------------------------------------------
+
+        /**
+         * @brief A* with the Euclidean distance as heuristic.
+         * @param t_grid The walkability.
+         * @param t_startNode The start.
+         * @param t_endNode The target.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_path Receives all map positions from the start to the target; a reused vector keeps its memory.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return bool
+         */
+        bool FindPath(
+            const TGrid& t_grid,
+            const Node& t_startNode,
+            const Node& t_endNode,
+            const AssetType& t_assetType,
+            std::vector<Node>& t_path,
+            const int t_footprint = 1
+        )
+        {
+            if (BeginSearch(t_grid, t_startNode.position, t_endNode.position, t_assetType, false, t_footprint) == SearchStatus::SEARCHING)
+            {
+                ContinueSearch(std::numeric_limits<std::size_t>::max());
+            }
+
+            GetPath(t_path);
+
+            return m_status == SearchStatus::FOUND;
+        }
+
+        //-------------------------------------------------
+        // Bidirectional A*
+        //-------------------------------------------------
+
+        /**
+         * @brief A* from the start and from the target at the same time; the side with the smaller
+         *        open list is expanded next. The search stops when no path through the open lists
+         *        can be shorter than the best meeting of both sides found so far.
+         *        Uses the Chebyshev distance as heuristic, so the path is a shortest path.
+         * @param t_grid The walkability.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_path Receives all map positions from the start to the target.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return bool
+         */
+        bool FindBidirectionalPath(
+            const TGrid& t_grid,
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            std::vector<Node>& t_path,
+            const int t_footprint = 1
+        )
+        {
+            if (BeginBidirectionalSearch(t_grid, t_startPosition, t_targetPosition, t_assetType, t_footprint) == SearchStatus::SEARCHING)
+            {
+                ContinueSearch(std::numeric_limits<std::size_t>::max());
+            }
+
+            GetPath(t_path);
+
+            return m_status == SearchStatus::FOUND;
+        }
+
+        /**
+         * @brief Starts a bidirectional A* without expanding a node; see `FindBidirectionalPath()`.
+         *        The grid must not change until the search is finished.
+         * @param t_grid The walkability.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return SearchStatus `NOT_FOUND` if the target can be rejected at once.
+         */
+        SearchStatus BeginBidirectionalSearch(
+            const TGrid& t_grid,
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            const int t_footprint = 1
+        )
+        {
+            if (BeginSearch(t_grid, t_startPosition, t_targetPosition, t_assetType, false, t_footprint) != SearchStatus::SEARCHING)
+            {
+                return m_status;
+            }
+
+            m_bidirectional = true;
+            m_meetingIndex = SearchArena::NO_PARENT;
+            m_bestLength = std::numeric_limits<float>::max();
+
+            // the backward search state is only needed for this search
+            if (m_backwardArena.GetSize() != m_arena.GetSize())
+            {
+                m_backwardArena.Resize(m_width, m_height);
+                m_backwardOpenList.Resize(m_width, m_height);
+            }
+
+            m_backwardArena.NewSearch();
+            m_backwardOpenList.Clear();
+
+            const auto startIndex{ IsoMath::From2DTo1D(t_startPosition.x, t_startPosition.y, m_width) };
+            const auto targetIndex{ IsoMath::From2DTo1D(t_targetPosition.x, t_targetPosition.y, m_width) };
+
+            m_startDistances = m_landmarks ? m_landmarks->GetDistances(startIndex) : nullptr;
+
+            // `BeginSearch()` has opened the start with f = 0
+            m_openList.Clear();
+            m_openList.Push(startIndex, GetBidirectionalKey(0.0f, t_startPosition, t_targetPosition, m_targetDistances));
+
+            m_backwardArena.Open(targetIndex, 0.0f, targetIndex);
+            m_backwardOpenList.Push(targetIndex, GetBidirectionalKey(0.0f, t_targetPosition, t_startPosition, m_startDistances));
+
+            return m_status;
+        }
+
+        //-------------------------------------------------
+        // Jump Point Search
+        //-------------------------------------------------
+
+        /**
+         * @brief Jump Point Search on the uniform-cost grid. Straight and diagonal lines are
+         *        skipped until a cell with a forced neighbour is found; only these jump points
+         *        are added to the open list. Uses the Chebyshev distance as heuristic.
+         * @param t_grid The walkability.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_path Receives all map positions from the start to the target.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return bool
+         */
+        bool FindJpsPath(
+            const TGrid& t_grid,
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            std::vector<Node>& t_path,
+            const int t_footprint = 1
+        )
+        {
+            if (BeginSearch(t_grid, t_startPosition, t_targetPosition, t_assetType, true, t_footprint) == SearchStatus::SEARCHING)
+            {
+                ContinueSearch(std::numeric_limits<std::size_t>::max());
+            }
+
+            GetPath(t_path);
+
+            return m_status == SearchStatus::FOUND;
+        }
+
+        //-------------------------------------------------
+        // Resumable search
+        //-------------------------------------------------
+
+        /**
+         * @brief Starts an A* or Jump Point Search without expanding a node.
+         *        Use `BeginBidirectionalSearch()` for a bidirectional A*.
+         *        The grid must not change until the search is finished.
+         * @param t_grid The walkability.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_jps Use Jump Point Search instead of A*.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return SearchStatus `NOT_FOUND` if the target can be rejected at once.
+         */
+        SearchStatus BeginSearch(
+            const TGrid& t_grid,
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType& t_assetType,
+            const bool t_jps,
+            const int t_footprint = 1
+        )
+        {
+            m_grid = &t_grid;
+            m_assetType = t_assetType;
+            m_footprint = t_footprint;
+            m_jps = t_jps;
+            m_bidirectional = false;
+            m_startPosition = t_startPosition;
+            m_targetPosition = t_targetPosition;
+            m_expandedNodes = 0;
+            m_jumpedFields = 0;
+            m_status = SearchStatus::NOT_FOUND;
+
+            if (!IsValid(t_targetPosition.x, t_targetPosition.y))
+            {
+                SG_ISLANDS_INFO("[GridSearch::BeginSearch()] Destination is an obstacle.");
+                return m_status;
+            }
+
+            if (t_startPosition == t_targetPosition)
+            {
+                SG_ISLANDS_INFO("[GridSearch::BeginSearch()] You are the target.");
+                return m_status;
+            }
+
+            // For example, you can not jump from one island to the other.
+            if (!m_grid->IsReachable(t_startPosition, t_targetPosition, m_assetType))
+            {
+                SG_ISLANDS_INFO("[GridSearch::BeginSearch()] Target not reachable.");
+                return m_status;
+            }
+
+            // invalidate the nodes of the last search
+            m_arena.NewSearch();
+            m_openList.Clear();
+
+            // the start is its own parent
+            const auto startIndex{ IsoMath::From2DTo1D(t_startPosition.x, t_startPosition.y, m_width) };
+
+            m_arena.Open(startIndex, 0.0f, startIndex);
+
+            // the landmark distances of the target are the same for each heuristic
+            m_landmarks = m_grid->GetLandmarks(m_assetType);
+            if (m_landmarks && m_landmarks->GetNumberOfLandmarks() > 0)
+            {
+                m_targetDistances = m_landmarks->GetDistances(IsoMath::From2DTo1D(t_targetPosition.x, t_targetPosition.y, m_width));
+            }
+            else
+            {
+                m_landmarks = nullptr;
+                m_targetDistances = nullptr;
+            }
+
+            m_openList.Push(startIndex, m_jps ? CalculateJpsHeuristic(t_startPosition) : 0.0f);
+
+            m_status = SearchStatus::SEARCHING;
+
+            return m_status;
+        }
+
+        /**
+         * @brief Continues the search started with `BeginSearch()`.
+         * @param t_maxCost The search is interrupted after this cost, see `GetSearchCost()`.
+         *                  A jump that reaches the cost stops after its next field and makes it
+         *                  a jump point, so the cost is exceeded by at most one field per direction.
+         * @return SearchStatus `SEARCHING` if interrupted.
+         */
+        SearchStatus ContinueSearch(const std::size_t t_maxCost)
+        {
+            if (m_status != SearchStatus::SEARCHING)
+            {
+                return m_status;
+            }
+
+            const auto cost{ GetSearchCost() };
+            const auto maxCost{ t_maxCost > std::numeric_limits<std::size_t>::max() - cost
+                ? std::numeric_limits<std::size_t>::max()
+                : cost + t_maxCost };
+
+            if (m_bidirectional)
+            {
+                return ContinueBidirectionalSearch(maxCost);
+            }
+
+            m_maxCost = maxCost;
+
+            while (!m_openList.IsEmpty() && GetSearchCost() < maxCost)
+            {
+                if (m_jps ? ExpandJpsNode() : ExpandNode())
+                {
+                    m_status = SearchStatus::FOUND;
+                    return m_status;
+                }
+            }
+
+            if (m_openList.IsEmpty())
+            {
+                SG_ISLANDS_INFO("[GridSearch::ContinueSearch()] Target not found.");
+                m_status = SearchStatus::NOT_FOUND;
+            }
+
+            return m_status;
+        }
+
+        /**
+         * @brief Returns the status of the current search.
+         * @return SearchStatus
+         */
+        SearchStatus GetStatus() const noexcept { return m_status; }
+
+        /**
+         * @brief Get the path of a finished search.
+         * @param t_path Receives all map positions from the start to the target; empty if not found.
+         */
+        void GetPath(std::vector<Node>& t_path) const
+        {
+            t_path.clear();
+
+            if (m_status != SearchStatus::FOUND)
+            {
+                return;
+            }
+
+            const auto startIndex{ IsoMath::From2DTo1D(m_startPosition.x, m_startPosition.y, m_width) };
+            const auto targetIndex{ IsoMath::From2DTo1D(m_targetPosition.x, m_targetPosition.y, m_width) };
+
+            if (m_jps)
+            {
+                MakeJpsPath(startIndex, targetIndex, t_path);
+            }
+            else if (m_bidirectional)
+            {
+                MakeBidirectionalPath(startIndex, targetIndex, t_path);
+            }
+            else
+            {
+                MakePath(startIndex, targetIndex, t_path);
+            }
+        }
+
+    protected:
+
+    private:
+        /**
+         * @brief The grid of the current search.
+         */
+        const TGrid* m_grid{ nullptr };
+
+        /**
+         * @brief The map width.
+         */
+        int m_width{ -1 };
+
+        /**
+         * @brief The map height.
+         */
+        int m_height{ -1 };
+
+        /**
+         * @brief The current asset type using in `FindPath()`.
+         */
+        AssetType m_assetType{ AssetType::NONE };
+
+        /**
+         * @brief The width and height of the unit in map fields.
+         */
+        int m_footprint{ 1 };
+
+        /**
+         * @brief True if the current search is a Jump Point Search.
+         */
+        bool m_jps{ false };
+
+        /**
+         * @brief True if the current search is a bidirectional A*.
+         */
+        bool m_bidirectional{ false };
+
+        sf::Vector2i m_startPosition;
+        sf::Vector2i m_targetPosition;
+
+        SearchStatus m_status{ SearchStatus::NOT_FOUND };
+
+        /**
+         * @brief The landmark distances of the grid and of the target; nullptr without landmarks.
+         */
+        const LandmarkTable* m_landmarks{ nullptr };
+        const LandmarkTable::Distance* m_targetDistances{ nullptr };
+        const LandmarkTable::Distance* m_startDistances{ nullptr };
+
+        /**
+         * @brief The per-cell search state is kept between the searches to avoid allocations;
+         *        its pages are only allocated in the parts of the map the searches have reached.
+         */
+        SearchArena m_arena;
+
+        /**
+         * @brief The open list is kept between the searches to avoid allocations.
+         */
+        OpenList m_openList;
+
+        /**
+         * @brief The search state from the target of a bidirectional A*; resized on first use.
+         */
+        SearchArena m_backwardArena;
+        OpenList m_backwardOpenList;
+
+        /**
+         * @brief The cell where the shortest path of a bidirectional A* joins both sides.
+         */
+        int m_meetingIndex{ SearchArena::NO_PARENT };
+
+        /**
+         * @brief The length of the shortest path through `m_meetingIndex`.
+         */
+        float m_bestLength{ std::numeric_limits<float>::max() };
+
+        /**
+         * @brief The number of nodes taken from the open list in the last search.
+         */
+        std::size_t m_expandedNodes{ 0 };
+
+        /**
+         * @brief The number of map fields the jumps of the last search walked over.
+         */
+        std::size_t m_jumpedFields{ 0 };
+
+        /**
+         * @brief The search cost at which the current slice ends; the jumps stop there.
+         */
+        std::size_t m_maxCost{ std::numeric_limits<std::size_t>::max() };
+
+        //-------------------------------------------------
+        // Expand
+        //-------------------------------------------------
+
+        /**
+         * @brief Expands the nodes of a bidirectional A*, the side with the smaller open list first.
+         * @param t_maxCost The search is interrupted at this search cost.
+         * @return SearchStatus `SEARCHING` if interrupted.
+         */
+        SearchStatus ContinueBidirectionalSearch(const std::size_t t_maxCost)
+        {
+            while (!m_openList.IsEmpty() && !m_backwardOpenList.IsEmpty())
+            {
+                // each f is a lower bound of all paths through its open list; the keys are f plus less than half a step
+                if (m_bestLength <= std::max(std::floor(m_openList.GetMinF()), std::floor(m_backwardOpenList.GetMinF())))
+                {
+                    break;
+                }
+
+                if (GetSearchCost() >= t_maxCost)
+                {
+                    return m_status;
+                }
+
+                if (m_openList.GetSize() <= m_backwardOpenList.GetSize())
+                {
+                    ExpandBidirectionalNode(m_arena, m_openList, m_backwardArena, m_targetPosition, m_targetDistances, m_bestLength);
+                }
+                else
+                {
+                    ExpandBidirectionalNode(m_backwardArena, m_backwardOpenList, m_arena, m_startPosition, m_startDistances, m_bestLength);
+                }
+            }
+
+            m_status = m_meetingIndex == SearchArena::NO_PARENT ? SearchStatus::NOT_FOUND : SearchStatus::FOUND;
+
+            if (m_status == SearchStatus::NOT_FOUND)
+            {
+                SG_ISLANDS_INFO("[GridSearch::ContinueBidirectionalSearch()] Target not found.");
+            }
+
+            return m_status;
+        }
+
+        /**
+         * @brief Expands the A* node with the lowest f.
+         * @return bool True if the target was found.
+         */
+        bool ExpandNode()
+        {
+            // get the node with the lowest f
+            const auto index{ m_openList.Pop() };
+
+            // only valid fields are opened, except for the start: a unit that does not fit
+            // there (e.g. after the map has changed) must still be able to leave it
+            const auto xPos{ index % m_width };
+            const auto yPos{ index / m_width };
+
+            m_arena.Close(index);
+            m_expandedNodes++;
+
+            const auto g{ m_arena.GetG(index) };
+
+            // for each neighbour
+            for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+            {
+                for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                {
+                    const auto newXPos{ xPos + xOffset };
+                    const auto newYPos{ yPos + yOffset };
+                    const auto newIndex{ IsoMath::From2DTo1D(newXPos, newYPos, m_width) };
+
+                    if (IsValid(newXPos, newYPos))
+                    {
+                        if (newXPos == m_targetPosition.x && newYPos == m_targetPosition.y)
+                        {
+                            m_arena.SetParent(newIndex, index);
+
+                            return true;
+                        }
+
+                        if (!m_arena.IsClosed(newIndex))
+                        {
+                            const auto newG{ g + 1.0f };
+                            const auto newH{ CalculateHeuristic(newXPos, newYPos) };
+                            const auto newF{ newG + newH };
+
+                            // check if this path is better than the one already present
+                            if (!m_arena.IsVisited(newIndex) ||
+                                m_arena.GetG(newIndex) + newH > newF)
+                            {
+                                // update the details of this neighbour node
+                                m_arena.Open(newIndex, newG, index);
+
+                                // add the node or decrease its key
+                                m_openList.Push(newIndex, newF);
+                            }
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Expands the jump point with the lowest f.
+         * @return bool True if the target was found.
+         */
+        bool ExpandJpsNode()
+        {
+            const auto index{ m_openList.Pop() };
+
+            if (index == IsoMath::From2DTo1D(m_targetPosition.x, m_targetPosition.y, m_width))
+            {
+                return true;
+            }
+
+            m_arena.Close(index);
+            m_expandedNodes++;
+
+            const sf::Vector2i position{ index % m_width, index / m_width };
+            const auto g{ m_arena.GetG(index) };
+
+            std::array<sf::Vector2i, 8> directions;
+            const auto numberOfDirections{ GetJpsDirections(position, m_arena.GetParent(index), directions) };
+
+            for (auto i{ 0 }; i < numberOfDirections; ++i)
+            {
+                sf::Vector2i jumpPoint;
+                if (!Jump(position, directions[i], m_targetPosition, jumpPoint))
+                {
+                    continue;
+                }
+
+                const auto jumpIndex{ IsoMath::From2DTo1D(jumpPoint.x, jumpPoint.y, m_width) };
+                if (m_arena.IsClosed(jumpIndex))
+                {
+                    continue;
+                }
+
+                // the cost of a straight or diagonal line of uniform steps
+                const auto newG{ g + Distance(position, jumpPoint) };
+                if (newG < m_arena.GetG(jumpIndex))
+                {
+                    m_arena.Open(jumpIndex, newG, index);
+                    m_openList.Push(jumpIndex, newG + CalculateJpsHeuristic(jumpPoint));
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Expands the node with the lowest f of one side of a bidirectional A*.
+         *        A neighbour already reached by the other side joins both halves to a path.
+         * @param t_arena The search state of this side.
+         * @param t_openList The open list of this side.
+         * @param t_otherArena The search state of the other side.
+         * @param t_goalPosition The start of the other side.
+         * @param t_goalDistances The landmark distances of the goal or nullptr.
+         * @param t_bestLength The length of the shortest path found so far.
+         */
+        void ExpandBidirectionalNode(
+            SearchArena& t_arena,
+            OpenList& t_openList,
+            const SearchArena& t_otherArena,
+            const sf::Vector2i& t_goalPosition,
+            const LandmarkTable::Distance* const t_goalDistances,
+            float& t_bestLength
+        )
+        {
+            const auto index{ t_openList.Pop() };
+
+            // only valid fields are opened, except for both starts
+            const auto xPos{ index % m_width };
+            const auto yPos{ index / m_width };
+
+            t_arena.Close(index);
+            m_expandedNodes++;
+
+            const auto newG{ t_arena.GetG(index) + 1.0f };
+
+            // the steps are symmetric, so both sides use the same neighbours
+            for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+            {
+                for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                {
+                    const auto newXPos{ xPos + xOffset };
+                    const auto newYPos{ yPos + yOffset };
+                    const auto newIndex{ IsoMath::From2DTo1D(newXPos, newYPos, m_width) };
+
+                    if (!IsValid(newXPos, newYPos) || t_arena.IsClosed(newIndex) || newG >= t_arena.GetG(newIndex))
+                    {
+                        continue;
+                    }
+
+                    t_arena.Open(newIndex, newG, index);
+                    t_openList.Push(newIndex, GetBidirectionalKey(newG, sf::Vector2i(newXPos, newYPos), t_goalPosition, t_goalDistances));
+
+                    if (t_otherArena.IsVisited(newIndex) && newG + t_otherArena.GetG(newIndex) < t_bestLength)
+                    {
+                        t_bestLength = newG + t_otherArena.GetG(newIndex);
+                        m_meetingIndex = newIndex;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Follows the parents of both sides from the meeting cell to the start and to the target.
+         */
+        void MakeBidirectionalPath(const int t_startIndex, const int t_targetIndex, std::vector<Node>& t_path) const
+        {
+            for (auto index{ m_meetingIndex }; ; index = m_arena.GetParent(index))
+            {
+                Node node;
+                node.position = sf::Vector2i(index % m_width, index / m_width);
+                t_path.push_back(node);
+
+                if (index == t_startIndex)
+                {
+                    break;
+                }
+            }
+
+            std::reverse(t_path.begin(), t_path.end());
+
+            for (auto index{ m_meetingIndex }; index != t_targetIndex; )
+            {
+                index = m_backwardArena.GetParent(index);
+
+                Node node;
+                node.position = sf::Vector2i(index % m_width, index / m_width);
+                t_path.push_back(node);
+            }
+
+            t_path.front().parentPosition = t_path.front().position;
+
+            for (std::size_t i{ 1 }; i < t_path.size(); ++i)
+            {
+                t_path[i].parentPosition = t_path[i - 1].position;
+                t_path[i].g = static_cast<float>(i);
+                t_path[i].f = t_path[i].g;
+            }
+        }
+
+        //-------------------------------------------------
+        // Jump Point Search Helper
+        //-------------------------------------------------
+
+        /**
+         * @brief The number of uniform steps on an empty 8-connected grid.
+         */
+        static float Distance(const sf::Vector2i& t_from, const sf::Vector2i& t_to)
+        {
+            return static_cast<float>(std::max(std::abs(t_from.x - t_to.x), std::abs(t_from.y - t_to.y)));
+        }
+
+        static int Sign(const int t_value)
+        {
+            return (t_value > 0) - (t_value < 0);
+        }
+
+        /**
+         * @brief Checks if a cell reached in the given direction has a neighbour that can
+         *        only be reached optimally through this cell.
+         */
+        bool HasForcedNeighbour(const sf::Vector2i& t_position, const sf::Vector2i& t_direction) const
+        {
+            const auto x{ t_position.x };
+            const auto y{ t_position.y };
+            const auto dx{ t_direction.x };
+            const auto dy{ t_direction.y };
+
+            if (dx != 0 && dy != 0)
+            {
+                return (!IsValid(x - dx, y) && IsValid(x - dx, y + dy)) ||
+                    (!IsValid(x, y - dy) && IsValid(x + dx, y - dy));
+            }
+
+            if (dx != 0)
+            {
+                return (!IsValid(x, y + 1) && IsValid(x + dx, y + 1)) ||
+                    (!IsValid(x, y - 1) && IsValid(x + dx, y - 1));
+            }
+
+            return (!IsValid(x + 1, y) && IsValid(x + 1, y + dy)) ||
+                (!IsValid(x - 1, y) && IsValid(x - 1, y + dy));
+        }
+
+        /**
+         * @brief Returns the directions to search from a jump point: all eight at the start,
+         *        otherwise the natural and the forced neighbours of the direction of arrival.
+         * @return int The number of directions.
+         */
+        int GetJpsDirections(const sf::Vector2i& t_position, const int t_parentIndex, std::array<sf::Vector2i, 8>& t_directions) const
+        {
+            auto count{ 0 };
+
+            const sf::Vector2i parent{ t_parentIndex % m_width, t_parentIndex / m_width };
+            if (parent == t_position)
+            {
+                for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+                {
+                    for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                    {
+                        if (xOffset != 0 || yOffset != 0)
+                        {
+                            t_directions[count++] = sf::Vector2i(xOffset, yOffset);
+                        }
+                    }
+                }
+
+                return count;
+            }
+
+            const auto x{ t_position.x };
+            const auto y{ t_position.y };
+            const auto dx{ Sign(t_position.x - parent.x) };
+            const auto dy{ Sign(t_position.y - parent.y) };
+
+            if (dx != 0 && dy != 0)
+            {
+                t_directions[count++] = sf::Vector2i(dx, 0);
+                t_directions[count++] = sf::Vector2i(0, dy);
+                t_directions[count++] = sf::Vector2i(dx, dy);
+
+                if (!IsValid(x - dx, y))
+                {
+                    t_directions[count++] = sf::Vector2i(-dx, dy);
+                }
+
+                if (!IsValid(x, y - dy))
+                {
+                    t_directions[count++] = sf::Vector2i(dx, -dy);
+                }
+            }
+            else if (dx != 0)
+            {
+                t_directions[count++] = sf::Vector2i(dx, 0);
+
+                if (!IsValid(x, y + 1))
+                {
+                    t_directions[count++] = sf::Vector2i(dx, 1);
+                }
+
+                if (!IsValid(x, y - 1))
+                {
+                    t_directions[count++] = sf::Vector2i(dx, -1);
+                }
+            }
+            else
+            {
+                t_directions[count++] = sf::Vector2i(0, dy);
+
+                if (!IsValid(x + 1, y))
+                {
+                    t_directions[count++] = sf::Vector2i(1, dy);
+                }
+
+                if (!IsValid(x - 1, y))
+                {
+                    t_directions[count++] = sf::Vector2i(-1, dy);
+                }
+            }
+
+            return count;
+        }
+
+        /**
+         * @brief Walks in a direction until the target, a cell with a forced neighbour or an obstacle.
+         *        A diagonal walk also stops where a straight walk would find a jump point.
+         *        At the end of the slice the walk stops at the current cell, which becomes an
+         *        intermediate jump point: it is expanded in the same directions later, so the
+         *        path stays a shortest path.
+         * @return bool False if an obstacle was hit.
+         */
+        bool Jump(sf::Vector2i t_position, const sf::Vector2i& t_direction, const sf::Vector2i& t_targetPosition, sf::Vector2i& t_jumpPoint)
+        {
+            const auto diagonal{ t_direction.x != 0 && t_direction.y != 0 };
+
+            while (true)
+            {
+                t_position += t_direction;
+                m_jumpedFields++;
+
+                if (!IsValid(t_position.x, t_position.y))
+                {
+                    return false;
+                }
+
+                if (t_position == t_targetPosition || HasForcedNeighbour(t_position, t_direction) || GetSearchCost() >= m_maxCost)
+                {
+                    t_jumpPoint = t_position;
+                    return true;
+                }
+
+                if (diagonal)
+                {
+                    // a straight walk that was stopped by the end of the slice also stops the diagonal walk here
+                    sf::Vector2i unused;
+                    if (Jump(t_position, sf::Vector2i(t_direction.x, 0), t_targetPosition, unused) ||
+                        Jump(t_position, sf::Vector2i(0, t_direction.y), t_targetPosition, unused))
+                    {
+                        t_jumpPoint = t_position;
+                        return true;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Follows the jump points back to the start and fills in the cells between them.
+         *        The cells are written into the path directly, so no other memory is needed.
+         */
+        void MakeJpsPath(const int t_startIndex, const int t_targetIndex, std::vector<Node>& t_path) const
+        {
+            Node node;
+
+            for (auto index{ t_targetIndex }; index != t_startIndex; index = m_arena.GetParent(index))
+            {
+                const auto parentIndex{ m_arena.GetParent(index) };
+                const sf::Vector2i parent{ parentIndex % m_width, parentIndex / m_width };
+
+                node.position = sf::Vector2i(index % m_width, index / m_width);
+
+                // a straight or diagonal line back to the previous jump point
+                const sf::Vector2i step{ Sign(parent.x - node.position.x), Sign(parent.y - node.position.y) };
+
+                for (; node.position != parent; node.position += step)
+                {
+                    t_path.push_back(node);
+                }
+            }
+
+            node.position = m_startPosition;
+            t_path.push_back(node);
+
+            std::reverse(t_path.begin(), t_path.end());
+
+            t_path.front().parentPosition = t_path.front().position;
+
+            for (std::size_t i{ 1 }; i < t_path.size(); ++i)
+            {
+                t_path[i].parentPosition = t_path[i - 1].position;
+                t_path[i].g = static_cast<float>(i);
+                t_path[i].f = t_path[i].g;
+            }
+        }
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * @brief Follows the parents from the target back to the start.
+         * @param t_startIndex The 1D index of the start.
+         * @param t_targetIndex The 1D index of the target.
+         * @param t_path Receives the path.
+         */
+        void MakePath(const int t_startIndex, const int t_targetIndex, std::vector<Node>& t_path) const
+        {
+            auto index{ t_targetIndex };
+
+            while (true)
+            {
+                t_path.push_back(CreateNode(index, t_startIndex));
+
+                if (index == t_startIndex)
+                {
+                    break;
+                }
+
+                index = m_arena.GetParent(index);
+                assert(index != SearchArena::NO_PARENT);
+            }
+
+            std::reverse(t_path.begin(), t_path.end());
+        }
+
+        /**
+         * @brief Creates a `Node` from the arena data of a cell.
+         * @param t_index The 1D index of the cell.
+         * @param t_startIndex The 1D index of the start node.
+         * @return Node
+         */
+        Node CreateNode(const int t_index, const int t_startIndex) const
+        {
+            const auto parentIndex{ m_arena.GetParent(t_index) };
+
+            Node node;
+            node.position = sf::Vector2i(t_index % m_width, t_index / m_width);
+            node.parentPosition = sf::Vector2i(parentIndex % m_width, parentIndex / m_width);
+            node.g = m_arena.GetG(t_index);
+            node.h = std::numeric_limits<float>::max();
+            node.f = std::numeric_limits<float>::max();
+
+            if (t_index == t_startIndex)
+            {
+                node.h = 0.0f;
+                node.f = 0.0f;
+            }
+            else if (node.g != std::numeric_limits<float>::max())
+            {
+                node.h = CalculateHeuristic(node.position.x, node.position.y);
+                node.f = node.g + node.h;
+            }
+
+            return node;
+        }
+
+        /**
+         * @brief Calculate the Euclidean distance from a position to the target,
+         *        or the landmark bound if it is larger.
+         * @param t_x The x-position.
+         * @param t_y The y-position.
+         * @return float
+         */
+        float CalculateHeuristic(const int t_x, const int t_y) const
+        {
+            const auto xd{ m_targetPosition.x - t_x };
+            const auto yd{ m_targetPosition.y - t_y };
+
+            const auto h{ static_cast<float>(sqrt(xd * xd + yd * yd)) }; // todo remove sqrt
+
+            return m_landmarks ? std::max(h, GetLandmarkBound(t_x, t_y)) : h;
+        }
+
+        /**
+         * @brief Calculate the number of steps in a straight line from a position to the target,
+         *        or the landmark bound if it is larger.
+         * @param t_position The position.
+         * @return float
+         */
+        float CalculateJpsHeuristic(const sf::Vector2i& t_position) const
+        {
+            const auto h{ Distance(t_position, m_targetPosition) };
+
+            return m_landmarks ? std::max(h, GetLandmarkBound(t_position.x, t_position.y)) : h;
+        }
+
+        /**
+         * @brief Calculate the number of steps in a straight line from a position to the goal
+         *        of one side of a bidirectional A*, or the landmark bound if it is larger.
+         * @param t_position The position.
+         * @param t_goalPosition The goal of the side.
+         * @param t_goalDistances The landmark distances of the goal or nullptr.
+         * @return float
+         */
+        float CalculateBidirectionalHeuristic(
+            const sf::Vector2i& t_position,
+            const sf::Vector2i& t_goalPosition,
+            const LandmarkTable::Distance* const t_goalDistances
+        ) const
+        {
+            const auto h{ Distance(t_position, t_goalPosition) };
+
+            return t_goalDistances
+                ? std::max(h, m_landmarks->GetLowerBound(IsoMath::From2DTo1D(t_position.x, t_position.y, m_width), t_goalDistances))
+                : h;
+        }
+
+        /**
+         * @brief The open list key of a bidirectional A*. Many cells of the uniform grid have the same f;
+         *        less than half a step per remaining straight step is added, so of these cells the one
+         *        nearest to the goal is expanded first. The f is the integral part of the key.
+         * @return float
+         */
+        float GetBidirectionalKey(
+            const float t_g,
+            const sf::Vector2i& t_position,
+            const sf::Vector2i& t_goalPosition,
+            const LandmarkTable::Distance* const t_goalDistances
+        ) const
+        {
+            const auto tieBreak{ 0.5f / static_cast<float>(std::max(m_width, m_height)) };
+
+            return t_g + CalculateBidirectionalHeuristic(t_position, t_goalPosition, t_goalDistances) + Distance(t_position, t_goalPosition) * tieBreak;
+        }
+
+        float GetLandmarkBound(const int t_x, const int t_y) const
+        {
+            return m_landmarks->GetLowerBound(IsoMath::From2DTo1D(t_x, t_y, m_width), m_targetDistances);
+        }
+
+        /**
+         * @brief Checks if a position is valid.
+         * @param t_x The x-position.
+         * @param t_y The y-position.
+         * @return bool
+         */
+        bool IsValid(const int t_x, const int t_y) const
+        {
+            return m_grid->IsWalkable(t_x, t_y, m_assetType, m_footprint);
+        }
+    };
+}
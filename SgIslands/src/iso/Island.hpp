@@ -2,7 +2,7 @@
 // 
 // Filename: Island.hpp
 // Created:  20.01.2019
-// Updated:  10.02.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -12,8 +12,14 @@
 #pragma once
 
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <vector>
 #include "../core/Types.hpp"
+#include "../core/Base64.hpp"
+#include "../core/Inflate.hpp"
 #include "TileAtlas.hpp"
 #include "IsoMath.hpp"
 
@@ -42,6 +48,26 @@ namespace sg::islands::iso
             LoadIslandFieldsFromFile(t_filename);
         }
 
+        /**
+         * @brief Creates an `Island` from tile ids which are already in memory, e.g. in a compiled map.
+         * @param t_width The `Island` width in tiles.
+         * @param t_height The `Island` height in tiles.
+         * @param t_tileIds `t_width * t_height` tile ids, row by row.
+         */
+        Island(const int t_width, const int t_height, const TileAtlas::TileId* t_tileIds)
+            : m_width{ t_width }
+            , m_height{ t_height }
+        {
+            const auto size{ static_cast<std::size_t>(m_width * m_height) };
+
+            m_islandFields.resize(size);
+            for (std::size_t i{ 0 }; i < size; ++i)
+            {
+                m_islandFields[i].tileId = t_tileIds[i];
+                m_islandFields[i].status = 1;
+            }
+        }
+
         Island(const Island& t_other) = delete;
         Island(Island&& t_other) noexcept = delete;
         Island& operator=(const Island& t_other) = delete;
@@ -228,10 +254,41 @@ namespace sg::islands::iso
             // get `<data>` element
             auto dataElement{ core::XmlWrapper::GetFirstChildElement(layerElement, "data") };
 
-            SG_ISLANDS_INFO("[Island::LoadIslandFieldsFromFile()] Loading tile Ids ...");
+            // Tiled writes the tiles either as `<tile>` elements or as encoded text
+            const auto encoding{ dataElement->Attribute("encoding") };
+
+            if (!encoding)
+            {
+                LoadTileElements(dataElement);
+            }
+            else if (std::strcmp(encoding, "csv") == 0)
+            {
+                LoadCsvTileIds(dataElement);
+            }
+            else if (std::strcmp(encoding, "base64") == 0)
+            {
+                LoadBase64TileIds(dataElement);
+            }
+            else
+            {
+                THROW_SG_EXCEPTION("[Island::LoadIslandFieldsFromFile()] Unsupported layer encoding: " + std::string(encoding));
+            }
+
+            assert(m_islandFields.size() == static_cast<size_t>(m_width * m_height));
+            SG_ISLANDS_INFO("[Island::LoadIslandFieldsFromFile()] Successfully loaded {} island fields.", m_islandFields.size());
+        }
+
+        /**
+         * @brief Reads the tile ids from one `<tile gid="">` element per field.
+         */
+        void LoadTileElements(const tinyxml2::XMLElement* const t_dataElement)
+        {
+            SG_ISLANDS_INFO("[Island::LoadTileElements()] Loading tile Ids ...");
+
+            m_islandFields.reserve(static_cast<std::size_t>(m_width * m_height));
 
             // get each tile
-            for (auto tile{ dataElement->FirstChildElement("tile") }; tile != nullptr; tile = tile->NextSiblingElement())
+            for (auto tile{ t_dataElement->FirstChildElement("tile") }; tile != nullptr; tile = tile->NextSiblingElement())
             {
                 TileAtlas::TileId tileId;
                 core::XmlWrapper::QueryAttribute(tile, "gid", &tileId);
@@ -243,9 +300,109 @@ namespace sg::islands::iso
                 // save `IslandField`
                 m_islandFields.push_back(islandField);
             }
+        }
 
-            assert(m_islandFields.size() == static_cast<size_t>(m_width * m_height));
-            SG_ISLANDS_INFO("[Island::LoadIslandFieldsFromFile()] Successfully loaded {} island fields.", m_islandFields.size());
+        /**
+         * @brief Reads the comma separated tile ids of a `<data encoding="csv">` element.
+         */
+        void LoadCsvTileIds(const tinyxml2::XMLElement* const t_dataElement)
+        {
+            SG_ISLANDS_INFO("[Island::LoadCsvTileIds()] Loading csv encoded tile Ids ...");
+
+            const auto text{ t_dataElement->GetText() };
+            if (!text)
+            {
+                THROW_SG_EXCEPTION("[Island::LoadCsvTileIds()] The layer data is empty.");
+            }
+
+            ResizeIslandFields();
+
+            std::size_t index{ 0 };
+            for (auto c{ text }; *c != '\0';)
+            {
+                if (*c == ',' || std::isspace(static_cast<unsigned char>(*c)))
+                {
+                    ++c;
+                    continue;
+                }
+
+                char* end{ nullptr };
+                const auto tileId{ std::strtoul(c, &end, 10) };
+                if (end == c || index >= m_islandFields.size())
+                {
+                    THROW_SG_EXCEPTION("[Island::LoadCsvTileIds()] Invalid csv layer data.");
+                }
+
+                m_islandFields[index++].tileId = static_cast<TileAtlas::TileId>(tileId);
+                c = end;
+            }
+
+            if (index != m_islandFields.size())
+            {
+                THROW_SG_EXCEPTION("[Island::LoadCsvTileIds()] Expected " + std::to_string(m_islandFields.size()) + " tile ids, got " + std::to_string(index) + ".");
+            }
+        }
+
+        /**
+         * @brief Reads the little-endian 32-bit tile ids of a `<data encoding="base64">` element,
+         *        uncompressed or with `compression="zlib"`.
+         */
+        void LoadBase64TileIds(const tinyxml2::XMLElement* const t_dataElement)
+        {
+            SG_ISLANDS_INFO("[Island::LoadBase64TileIds()] Loading base64 encoded tile Ids ...");
+
+            const auto text{ t_dataElement->GetText() };
+            if (!text)
+            {
+                THROW_SG_EXCEPTION("[Island::LoadBase64TileIds()] The layer data is empty.");
+            }
+
+            ResizeIslandFields();
+
+            const auto expectedSize{ m_islandFields.size() * 4 };
+
+            auto bytes{ core::Base64::Decode(text) };
+
+            const auto compression{ t_dataElement->Attribute("compression") };
+            if (compression && std::strcmp(compression, "zlib") == 0)
+            {
+                bytes = core::Inflate::DecompressZlib(bytes, expectedSize);
+            }
+            else if (compression)
+            {
+                THROW_SG_EXCEPTION("[Island::LoadBase64TileIds()] Unsupported layer compression: " + std::string(compression));
+            }
+
+            if (bytes.size() != expectedSize)
+            {
+                THROW_SG_EXCEPTION("[Island::LoadBase64TileIds()] Expected " + std::to_string(expectedSize) + " bytes, got " + std::to_string(bytes.size()) + ".");
+            }
+
+            for (std::size_t i{ 0 }; i < m_islandFields.size(); ++i)
+            {
+                const auto* const tile{ &bytes[i * 4] };
+
+                m_islandFields[i].tileId = static_cast<TileAtlas::TileId>(
+                    static_cast<std::uint32_t>(tile[0]) |
+                    static_cast<std::uint32_t>(tile[1]) << 8 |
+                    static_cast<std::uint32_t>(tile[2]) << 16 |
+                    static_cast<std::uint32_t>(tile[3]) << 24
+                );
+            }
+        }
+
+        /**
+         * @brief Creates `width * height` fields for the encoded layers to fill in place.
+         */
+        void ResizeIslandFields()
+        {
+            if (m_width <= 0 || m_height <= 0)
+            {
+                THROW_SG_EXCEPTION("[Island::ResizeIslandFields()] Invalid island size.");
+            }
+
+            const auto status{ 1 };
+            m_islandFields.assign(static_cast<std::size_t>(m_width * m_height), IslandField{ -1, status });
         }
     };
 }
@@ -2,7 +2,7 @@
 // 
 // Filename: IsoMath.hpp
 // Created:  22.01.2019
-// Updated:  18.02.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -11,6 +11,10 @@
 
 #pragma once
 
+#include <cmath>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/View.hpp>
+
 namespace sg::islands::iso
 {
     /**
@@ -115,6 +119,45 @@ namespace sg::islands::iso
             return sf::Vector2i(static_cast<int>(floor(mapX)), static_cast<int>(floor(mapY)));
         }
 
+        /**
+         * @brief The inverse of `ToScreen()` with correction: the map position whose unit position is nearest.
+         * @param t_screenCoords The screen position of a unit.
+         * @return sf::Vector2i()
+         */
+        static auto ToNearestMap(const sf::Vector2f& t_screenCoords)
+        {
+            const auto mapX{ (t_screenCoords.x / DEFAULT_TILE_WIDTH_HALF + t_screenCoords.y / DEFAULT_TILE_HEIGHT_HALF) / 2 - 1 };
+            const auto mapY{ (t_screenCoords.y / DEFAULT_TILE_HEIGHT_HALF - t_screenCoords.x / DEFAULT_TILE_WIDTH_HALF) / 2 - 1 };
+
+            return sf::Vector2i(static_cast<int>(round(mapX)), static_cast<int>(round(mapY)));
+        }
+
+        /**
+         * @brief The map area that can be seen through a view. The screen rectangle of the view is a
+         *        diamond on the map; the result is the bounding box of the map positions of its corners.
+         * @param t_view The view.
+         * @param t_margin Map fields added on each side for images that reach beyond their map field.
+         * @return sf::IntRect The area in map positions; it is not clipped to the map.
+         */
+        static auto ToMapArea(const sf::View& t_view, const int t_margin)
+        {
+            const auto center{ t_view.getCenter() };
+            const auto halfSize{ t_view.getSize() / 2.0f };
+
+            // x grows to the right and down, y grows to the left and down
+            const auto topLeft{ ToMap(sf::Vector2f(center.x - halfSize.x, center.y - halfSize.y)) };
+            const auto topRight{ ToMap(sf::Vector2f(center.x + halfSize.x, center.y - halfSize.y)) };
+            const auto bottomLeft{ ToMap(sf::Vector2f(center.x - halfSize.x, center.y + halfSize.y)) };
+            const auto bottomRight{ ToMap(sf::Vector2f(center.x + halfSize.x, center.y + halfSize.y)) };
+
+            const auto left{ topLeft.x - t_margin };
+            const auto top{ topRight.y - t_margin };
+            const auto right{ bottomRight.x + t_margin };
+            const auto bottom{ bottomLeft.y + t_margin };
+
+            return sf::IntRect(left, top, right - left + 1, bottom - top + 1);
+        }
+
     protected:
 
     private:
@@ -0,0 +1,341 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: LandmarkTable.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "IsoMath.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief The exact distances from a few landmark cells to every cell (ALT heuristic).
+     *        By the triangle inequality, |d(L, target) - d(L, cell)| never overestimates the distance
+     *        from a cell to the target, but unlike the straight line it knows about the islands in between.
+     *        A step to one of the 8 neighbours costs 1, like in `GridSearch`.
+     *        The walkability is passed as callable `bool(int x, int y)`. A built table is not changed.
+     */
+    class LandmarkTable
+    {
+    public:
+        using Distance = std::uint16_t;
+
+        static constexpr Distance UNREACHABLE{ std::numeric_limits<Distance>::max() };
+        static constexpr int DEFAULT_NUMBER_OF_LANDMARKS{ 8 };
+
+        /**
+         * @brief Smaller regions, such as lagoons, get no landmark.
+         */
+        static constexpr int MIN_REGION_SIZE{ 64 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        LandmarkTable() = default;
+
+        LandmarkTable(const LandmarkTable& t_other) = delete;
+        LandmarkTable(LandmarkTable&& t_other) noexcept = delete;
+        LandmarkTable& operator=(const LandmarkTable& t_other) = delete;
+        LandmarkTable& operator=(LandmarkTable&& t_other) noexcept = delete;
+
+        ~LandmarkTable() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        int GetNumberOfLandmarks() const noexcept { return static_cast<int>(m_landmarks.size()); }
+
+        const sf::Vector2i& GetLandmark(const int t_landmark) const { return m_landmarks[t_landmark]; }
+
+        /**
+         * @brief Get the walkability of a cell at the time the table was built.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @return bool
+         */
+        bool WasWalkable(const int t_mapX, const int t_mapY) const
+        {
+            return m_walkable[IsoMath::From2DTo1D(t_mapX, t_mapY, m_width)] != 0;
+        }
+
+        /**
+         * @brief Get the distances of a cell to all landmarks.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return const Distance* `GetNumberOfLandmarks()` values; `UNREACHABLE` for another region.
+         */
+        const Distance* GetDistances(const int t_cellIndex) const
+        {
+            return &m_distances[static_cast<std::size_t>(t_cellIndex) * m_landmarks.size()];
+        }
+
+        /**
+         * @brief Get the lower bound of the distance from a cell to a target.
+         * @param t_cellIndex The 1D index of the cell.
+         * @param t_targetDistances The distances of the target from `GetDistances()`.
+         * @return float
+         */
+        float GetLowerBound(const int t_cellIndex, const Distance* const t_targetDistances) const
+        {
+            const auto* const distances{ GetDistances(t_cellIndex) };
+            auto bound{ 0 };
+
+            for (std::size_t i{ 0 }; i < m_landmarks.size(); ++i)
+            {
+                if (distances[i] != UNREACHABLE && t_targetDistances[i] != UNREACHABLE)
+                {
+                    bound = std::max(bound, std::abs(static_cast<int>(distances[i]) - static_cast<int>(t_targetDistances[i])));
+                }
+            }
+
+            return static_cast<float>(bound);
+        }
+
+        //-------------------------------------------------
+        // Build
+        //-------------------------------------------------
+
+        /**
+         * @brief Places the landmarks and computes their distances with a breadth-first search each.
+         *        Each landmark is the cell farthest from the landmarks placed so far; a large region
+         *        without a landmark comes first.
+         * @tparam TWalkable Callable `bool(int, int)`.
+         * @param t_width The map width.
+         * @param t_height The map height.
+         * @param t_numberOfLandmarks The maximum number of landmarks.
+         * @param t_isWalkable Checks if a cell can be entered.
+         */
+        template <typename TWalkable>
+        void Build(const int t_width, const int t_height, const int t_numberOfLandmarks, TWalkable t_isWalkable)
+        {
+            m_width = t_width;
+            m_height = t_height;
+
+            const auto numberOfCells{ static_cast<std::size_t>(m_width * m_height) };
+
+            m_walkable.resize(numberOfCells);
+            for (auto y{ 0 }; y < m_height; ++y)
+            {
+                for (auto x{ 0 }; x < m_width; ++x)
+                {
+                    m_walkable[IsoMath::From2DTo1D(x, y, m_width)] = t_isWalkable(x, y) ? 1 : 0;
+                }
+            }
+
+            LabelRegions();
+
+            // the distance of each cell to its nearest landmark
+            std::vector<Distance> nearest(numberOfCells, UNREACHABLE);
+            std::vector<std::vector<Distance>> distances;
+
+            m_landmarks.clear();
+
+            while (static_cast<int>(m_landmarks.size()) < t_numberOfLandmarks)
+            {
+                const auto landmark{ FindFarthestCell(nearest) };
+                if (landmark < 0)
+                {
+                    break;
+                }
+
+                m_landmarks.emplace_back(landmark % m_width, landmark / m_width);
+                distances.emplace_back(numberOfCells, UNREACHABLE);
+
+                ComputeDistances(landmark, distances.back());
+
+                for (std::size_t i{ 0 }; i < numberOfCells; ++i)
+                {
+                    nearest[i] = std::min(nearest[i], distances.back()[i]);
+                }
+            }
+
+            // all distances of a cell are read together
+            m_distances.resize(numberOfCells * m_landmarks.size());
+            for (std::size_t i{ 0 }; i < numberOfCells; ++i)
+            {
+                for (std::size_t landmark{ 0 }; landmark < m_landmarks.size(); ++landmark)
+                {
+                    m_distances[i * m_landmarks.size() + landmark] = distances[landmark][i];
+                }
+            }
+
+            m_regions.clear();
+            m_regions.shrink_to_fit();
+            m_regionSizes.clear();
+            m_queue.clear();
+            m_queue.shrink_to_fit();
+        }
+
+    protected:
+
+    private:
+        int m_width{ 0 };
+        int m_height{ 0 };
+
+        std::vector<sf::Vector2i> m_landmarks;
+
+        /**
+         * @brief The distances to all landmarks per cell.
+         */
+        std::vector<Distance> m_distances;
+
+        /**
+         * @brief The walkability per cell; to find out if a change of the `Map` concerns the table.
+         */
+        std::vector<std::uint8_t> m_walkable;
+
+        /**
+         * @brief The region per cell and the region sizes; only used while building.
+         */
+        std::vector<int> m_regions;
+        std::vector<int> m_regionSizes;
+
+        /**
+         * @brief Queue for the breadth-first searches.
+         */
+        std::vector<int> m_queue;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        bool IsWalkable(const int t_mapX, const int t_mapY) const
+        {
+            if (t_mapX < 0 || t_mapY < 0 || t_mapX >= m_width || t_mapY >= m_height)
+            {
+                return false;
+            }
+
+            return m_walkable[IsoMath::From2DTo1D(t_mapX, t_mapY, m_width)] != 0;
+        }
+
+        /**
+         * @brief Visits the walkable neighbours of a cell.
+         */
+        template <typename TVisit>
+        void ForEachNeighbour(const int t_cellIndex, TVisit t_visit) const
+        {
+            const auto x{ t_cellIndex % m_width };
+            const auto y{ t_cellIndex / m_width };
+
+            for (auto yOffset{ -1 }; yOffset <= 1; ++yOffset)
+            {
+                for (auto xOffset{ -1 }; xOffset <= 1; ++xOffset)
+                {
+                    if ((xOffset != 0 || yOffset != 0) && IsWalkable(x + xOffset, y + yOffset))
+                    {
+                        t_visit(IsoMath::From2DTo1D(x + xOffset, y + yOffset, m_width));
+                    }
+                }
+            }
+        }
+
+        void LabelRegions()
+        {
+            m_regions.assign(m_walkable.size(), -1);
+            m_regionSizes.clear();
+
+            for (std::size_t i{ 0 }; i < m_walkable.size(); ++i)
+            {
+                if (!m_walkable[i] || m_regions[i] >= 0)
+                {
+                    continue;
+                }
+
+                const auto region{ static_cast<int>(m_regionSizes.size()) };
+
+                m_queue.clear();
+                m_queue.push_back(static_cast<int>(i));
+                m_regions[i] = region;
+
+                for (std::size_t next{ 0 }; next < m_queue.size(); ++next)
+                {
+                    ForEachNeighbour(m_queue[next], [this, region](const int t_neighbour)
+                    {
+                        if (m_regions[t_neighbour] < 0)
+                        {
+                            m_regions[t_neighbour] = region;
+                            m_queue.push_back(t_neighbour);
+                        }
+                    });
+                }
+
+                m_regionSizes.push_back(static_cast<int>(m_queue.size()));
+            }
+        }
+
+        /**
+         * @brief Finds the next landmark: an unreached cell of the largest region without a landmark,
+         *        otherwise the cell with the largest distance to its nearest landmark.
+         * @return int The 1D index or -1 if no cell is left.
+         */
+        int FindFarthestCell(const std::vector<Distance>& t_nearest) const
+        {
+            auto best{ -1 };
+
+            for (std::size_t i{ 0 }; i < t_nearest.size(); ++i)
+            {
+                if (!m_walkable[i] || m_regionSizes[m_regions[i]] < MIN_REGION_SIZE)
+                {
+                    continue;
+                }
+
+                if (best < 0 ||
+                    t_nearest[i] > t_nearest[best] ||
+                    (t_nearest[i] == UNREACHABLE && t_nearest[best] == UNREACHABLE && m_regionSizes[m_regions[i]] > m_regionSizes[m_regions[best]]))
+                {
+                    best = static_cast<int>(i);
+                }
+            }
+
+            // the cell is already a landmark
+            if (best >= 0 && t_nearest[best] == 0)
+            {
+                return -1;
+            }
+
+            return best;
+        }
+
+        void ComputeDistances(const int t_landmark, std::vector<Distance>& t_distances)
+        {
+            m_queue.clear();
+            m_queue.push_back(t_landmark);
+            t_distances[t_landmark] = 0;
+
+            for (std::size_t next{ 0 }; next < m_queue.size(); ++next)
+            {
+                const auto cellIndex{ m_queue[next] };
+
+                // a saturated distance still gives a valid, only weaker, bound
+                const auto distance{ static_cast<Distance>(std::min<int>(t_distances[cellIndex] + 1, UNREACHABLE - 1)) };
+
+                ForEachNeighbour(cellIndex, [this, &t_distances, distance](const int t_neighbour)
+                {
+                    if (t_distances[t_neighbour] == UNREACHABLE)
+                    {
+                        t_distances[t_neighbour] = distance;
+                        m_queue.push_back(t_neighbour);
+                    }
+                });
+            }
+        }
+    };
+
+    using LandmarkTableSharedPtr = std::shared_ptr<const LandmarkTable>;
+}
@@ -2,7 +2,7 @@
 // 
 // Filename: Map.hpp
 // Created:  20.01.2019
-// Updated:  04.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -11,35 +11,47 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <limits>
+#include <string>
 #include "Island.hpp"
 #include "IsoMath.hpp"
 #include "Asset.hpp"
+#include "MapFieldChunks.hpp"
+#include "ConnectedComponents.hpp"
+#include "ClearanceMap.hpp"
+#include "LandmarkTable.hpp"
+#include "MapFormat.hpp"
+#include "TerrainMesh.hpp"
+#include "TerrainChunkCache.hpp"
+#include "DeepWater.hpp"
+#include "../core/ResourceHolder.hpp"
+#include "../core/ThreadPool.hpp"
 
 namespace sg::islands::iso
 {
-    enum class TerrainType
-    {
-        DEEP_WATER,
-        LAND,
-    };
-
-    struct MapField
-    {
-        TileAtlas::TileId terrainTileId;
-        TerrainType terrainType;
-        AssetId assetId;
-        bool passable;
-        bool selected;
-    };
-
     using IslandUniquePtr = std::unique_ptr<Island>;
     using Islands = std::vector<IslandUniquePtr>;
-    using MapFields = std::vector<MapField>;
-
+    using MapChangeListener = std::function<void(int, int)>;
+    using MapChangeListeners = std::vector<MapChangeListener>;
+
+    /**
+     * @brief The map fields are stored in chunks of 32 x 32 fields; only the chunks with land or
+     *        a change have own memory. Within a chunk, land, passable and the walkability of each
+     *        unit type are bits, so a search reads 32 map fields with one word.
+     */
     class Map
     {
     public:
-        static constexpr AssetId NO_ASSET{ -1 };
+        static constexpr AssetId NO_ASSET{ MapFieldChunks::NO_ASSET };
+
+        /**
+         * @brief The map fields drawn around the view; tiles and the grid texts reach beyond their map field.
+         */
+        static constexpr auto VIEW_MARGIN{ 3 };
 
         //-------------------------------------------------
         // Ctor. && Dtor.
@@ -47,10 +59,25 @@ namespace sg::islands::iso
 
         Map() = delete;
 
-        explicit Map(const core::Filename& t_filename)
+        /**
+         * @brief Loads a map from a xml or a compiled map file.
+         * @param t_filename The map file.
+         * @param t_threadPool Loads the island files of a xml map at the same time; optional.
+         */
+        explicit Map(const core::Filename& t_filename, core::ThreadPool* const t_threadPool = nullptr)
         {
-            LoadMapFile(t_filename);
+            if (MapFormat::IsCompiledMap(t_filename))
+            {
+                LoadCompiledMapFile(t_filename);
+            }
+            else
+            {
+                LoadMapFile(t_filename, t_threadPool);
+            }
+
             GenerateMapFields();
+            GenerateComponents();
+            GenerateClearance();
         }
 
         Map(const Map& t_other) = delete;
@@ -108,7 +135,7 @@ namespace sg::islands::iso
          */
         auto IsDeepWater(const int t_mapX, const int t_mapY) const
         {
-            return m_mapFields[IsoMath::From2DTo1D(t_mapX, t_mapY, m_mapWidth)].terrainType == TerrainType::DEEP_WATER;
+            return !m_fields.IsLand(t_mapX, t_mapY);
         }
 
         /**
@@ -119,7 +146,18 @@ namespace sg::islands::iso
          */
         auto IsLand(const int t_mapX, const int t_mapY) const
         {
-            return m_mapFields[IsoMath::From2DTo1D(t_mapX, t_mapY, m_mapWidth)].terrainType == TerrainType::LAND;
+            return m_fields.IsLand(t_mapX, t_mapY);
+        }
+
+        /**
+         * @brief Return the terrain tile of the given position.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @return TileAtlas::TileId -1 for deep water.
+         */
+        auto GetTerrainTileId(const int t_mapX, const int t_mapY) const
+        {
+            return m_fields.GetTerrainTileId(t_mapX, t_mapY);
         }
 
         /**
@@ -130,7 +168,7 @@ namespace sg::islands::iso
          */
         auto GetAssetId(const int t_mapX, const int t_mapY) const
         {
-            return m_mapFields[IsoMath::From2DTo1D(t_mapX, t_mapY, m_mapWidth)].assetId;
+            return m_fields.GetAssetId(t_mapX, t_mapY);
         }
 
         /**
@@ -141,13 +179,170 @@ namespace sg::islands::iso
          */
         auto IsPassable(const int t_mapX, const int t_mapY) const
         {
-            return m_mapFields[IsoMath::From2DTo1D(t_mapX, t_mapY, m_mapWidth)].passable;
+            return m_fields.IsPassable(t_mapX, t_mapY);
+        }
+
+        /**
+         * @brief Checks if a unit of the given type can enter the target.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return bool
+         */
+        bool IsWalkable(const int t_mapX, const int t_mapY, const AssetType t_assetType) const
+        {
+            if (t_mapX < 0 || t_mapY < 0 || t_mapX >= m_mapWidth || t_mapY >= m_mapHeight)
+            {
+                return false;
+            }
+
+            return m_fields.IsWalkable(t_mapX, t_mapY, t_assetType);
+        }
+
+        /**
+         * @brief Checks if a unit of the given type and size can stand on the target.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields; the unit is centered on the target.
+         * @return bool
+         */
+        bool IsWalkable(const int t_mapX, const int t_mapY, const AssetType t_assetType, const int t_footprint) const
+        {
+            if (t_footprint <= 1)
+            {
+                return IsWalkable(t_mapX, t_mapY, t_assetType);
+            }
+
+            return GetClearance(t_assetType).Fits(t_mapX, t_mapY, t_footprint);
+        }
+
+        /**
+         * @brief Checks in O(1) if a unit of the given type can get from one position to another.
+         * @param t_from The start map position.
+         * @param t_to The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return bool
+         */
+        bool IsReachable(const sf::Vector2i& t_from, const sf::Vector2i& t_to, const AssetType t_assetType) const
+        {
+            if (!IsWalkable(t_from.x, t_from.y, t_assetType) || !IsWalkable(t_to.x, t_to.y, t_assetType))
+            {
+                return false;
+            }
+
+            return GetComponents(t_assetType).IsConnected(t_from.x, t_from.y, t_to.x, t_to.y);
+        }
+
+        /**
+         * @brief Get the map fields that can be seen through a view.
+         * @param t_view The view.
+         * @param t_margin Map fields added on each side.
+         * @return sf::IntRect The area in map positions, clipped to the map; it can be empty.
+         */
+        sf::IntRect GetVisibleArea(const sf::View& t_view, const int t_margin = VIEW_MARGIN) const
+        {
+            const auto area{ IsoMath::ToMapArea(t_view, t_margin) };
+
+            const auto left{ std::max(area.left, 0) };
+            const auto top{ std::max(area.top, 0) };
+            const auto right{ std::min(area.left + area.width, m_mapWidth) };
+            const auto bottom{ std::min(area.top + area.height, m_mapHeight) };
+
+            return sf::IntRect(left, top, std::max(right - left, 0), std::max(bottom - top, 0));
+        }
+
+        /**
+         * @brief Get the map fields; a copy shares the chunks with the `Map`.
+         * @return Const reference to `MapFieldChunks`
+         */
+        const MapFieldChunks& GetFields() const noexcept { return m_fields; }
+
+        /**
+         * @brief Get the number of walkability changes since the `Map` was created.
+         * @return std::uint32_t
+         */
+        auto GetVersion() const noexcept { return m_version; }
+
+        /**
+         * @brief Get the connected regions for the given type of unit.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return Const reference to `ConnectedComponents`
+         */
+        const ConnectedComponents& GetComponents(const AssetType t_assetType) const
+        {
+            assert(t_assetType == AssetType::WATER_UNIT || t_assetType == AssetType::LAND_UNIT);
+
+            return t_assetType == AssetType::WATER_UNIT ? m_waterComponents : m_landComponents;
+        }
+
+        /**
+         * @brief Get the clearance for the given type of unit.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return Const reference to `ClearanceMap`
+         */
+        const ClearanceMap& GetClearance(const AssetType t_assetType) const
+        {
+            assert(t_assetType == AssetType::WATER_UNIT || t_assetType == AssetType::LAND_UNIT);
+
+            return t_assetType == AssetType::WATER_UNIT ? m_waterClearance : m_landClearance;
+        }
+
+        /**
+         * @brief Checks if the searches use the landmark distances as heuristic (ALT).
+         * @return bool
+         */
+        bool IsLandmarksEnabled() const noexcept { return m_landmarksEnabled; }
+
+        /**
+         * @brief Get the landmark distances for the given type of unit.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return const LandmarkTable* or nullptr if the landmarks are disabled.
+         */
+        const LandmarkTable* GetLandmarks(const AssetType t_assetType) const
+        {
+            return GetLandmarkTable(t_assetType).get();
+        }
+
+        /**
+         * @brief Get the landmark distances for the given type of unit, to keep them alive in another thread.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return LandmarkTableSharedPtr or nullptr if the landmarks are disabled.
+         */
+        LandmarkTableSharedPtr GetLandmarkTable(const AssetType t_assetType) const
+        {
+            assert(t_assetType == AssetType::WATER_UNIT || t_assetType == AssetType::LAND_UNIT);
+
+            if (!m_landmarksEnabled)
+            {
+                return nullptr;
+            }
+
+            return t_assetType == AssetType::WATER_UNIT ? m_waterLandmarks : m_landLandmarks;
         }
 
         //-------------------------------------------------
         // Setter
         //-------------------------------------------------
 
+        /**
+         * @brief Enables or disables the landmark heuristic. The tables are built in the next `UpdateLandmarks()`.
+         * @param t_landmarksEnabled bool
+         */
+        void SetLandmarksEnabled(const bool t_landmarksEnabled) { m_landmarksEnabled = t_landmarksEnabled; }
+
+        /**
+         * @brief Set the maximum memory of the pre-rendered terrain chunks.
+         * @param t_budget The budget in bytes.
+         */
+        void SetTerrainCacheBudget(const std::size_t t_budget) { m_terrainChunkCache.SetBudget(t_budget); }
+
+        /**
+         * @brief Set the distance in pixels the deep water moves each second.
+         * @param t_flow The flow; zero stops the water.
+         */
+        void SetDeepWaterFlow(const sf::Vector2f& t_flow) { m_deepWater.SetFlow(t_flow); }
+
         /**
          * @brief Set an `Asset` Id.
          * @param t_mapX The x-map position.
@@ -156,7 +351,8 @@ namespace sg::islands::iso
          */
         void SetAssetId(const int t_mapX, const int t_mapY, const AssetId t_assetId)
         {
-            m_mapFields[IsoMath::From2DTo1D(t_mapX, t_mapY, m_mapWidth)].assetId = t_assetId;
+            // the walkability does not depend on the `Asset`s, so nothing derived is outdated
+            m_fields.SetAssetId(t_mapX, t_mapY, t_assetId);
         }
 
         /**
@@ -177,7 +373,34 @@ namespace sg::islands::iso
          */
         void SetPassable(const int t_mapX, const int t_mapY, const bool t_passable)
         {
-            m_mapFields[IsoMath::From2DTo1D(t_mapX, t_mapY, m_mapWidth)].passable = t_passable;
+            const auto walkability{ GetWalkability(t_mapX, t_mapY) };
+
+            m_fields.SetPassable(t_mapX, t_mapY, t_passable);
+            UpdateMapField(t_mapX, t_mapY, walkability);
+        }
+
+        /**
+         * @brief Changes the terrain tile of a map field; the field becomes a land field.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_tileId The terrain tile id as in the island files.
+         */
+        void SetTerrainTileId(const int t_mapX, const int t_mapY, const TileAtlas::TileId t_tileId)
+        {
+            const auto walkability{ GetWalkability(t_mapX, t_mapY) };
+
+            m_fields.SetLand(t_mapX, t_mapY, t_tileId);
+            m_terrainMesh.Invalidate(t_mapX, t_mapY);
+            UpdateMapField(t_mapX, t_mapY, walkability);
+        }
+
+        /**
+         * @brief Registers a function that is called with the map position of each changed map field.
+         * @param t_listener The function to call.
+         */
+        void AddChangeListener(MapChangeListener t_listener)
+        {
+            m_changeListeners.push_back(std::move(t_listener));
         }
 
         //-------------------------------------------------
@@ -189,24 +412,8 @@ namespace sg::islands::iso
          */
         void GenerateMapFields()
         {
-            // "clear" map with deep water
-            for (auto y{ 0 }; y < m_mapHeight; ++y)
-            {
-                for (auto x{ 0 }; x < m_mapWidth; ++x)
-                {
-                    MapField mapField{};
-
-                    mapField.terrainTileId = -1;
-                    mapField.terrainType = TerrainType::DEEP_WATER;
-                    mapField.assetId = NO_ASSET;
-                    mapField.passable = true;
-                    mapField.selected = false;
-
-                    m_mapFields.push_back(mapField);
-                }
-            }
-
-            assert(m_mapFields.size() == static_cast<std::size_t>(m_mapWidth * m_mapHeight));
+            // "clear" map with completely passable deep water
+            m_fields.Resize(m_mapWidth, m_mapHeight);
 
             // go through all islands
             for (const auto& island : m_islands)
@@ -219,22 +426,92 @@ namespace sg::islands::iso
                         const auto xMapPos{ x + island->GetXOffset() };
                         const auto yMapPos{ y + island->GetYOffset() };
 
-                        // from 2D to 1D
-                        const auto index{ IsoMath::From2DTo1D(xMapPos, yMapPos, m_mapWidth) };
-
                         // set terrain
-                        m_mapFields[index].terrainTileId = island->GetIslandFieldByMapPosition(xMapPos, yMapPos).tileId;
-                        m_mapFields[index].terrainType = TerrainType::LAND;
-                        m_mapFields[index].assetId = NO_ASSET; // so far no assets
-                        m_mapFields[index].passable = true; // completely passable terrain
-                        m_mapFields[index].selected = false;
+                        m_fields.SetLand(xMapPos, yMapPos, island->GetIslandFieldByMapPosition(xMapPos, yMapPos).tileId);
                     }
                 }
             }
 
+            // the vertices are built with the first draw
+            m_terrainMesh.Resize(m_mapWidth, m_mapHeight);
+            m_deepWater.Resize(m_deepWaterWidth, m_deepWaterHeight);
+
+            SG_ISLANDS_INFO("[Map::GenerateMapFields()] {} of {} chunks with own memory.",
+                m_fields.GetNumberOfMaterializedChunks(), m_fields.GetNumberOfChunks());
+
             SG_ISLANDS_INFO("[Map::GenerateTerrainMap()] Map with terrain information created.");
         }
 
+        /**
+         * @brief Labels the connected water and land regions. Must be called after `GenerateMapFields()`.
+         */
+        void GenerateComponents()
+        {
+            m_waterComponents.Build(m_mapWidth, m_mapHeight, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, AssetType::WATER_UNIT);
+            });
+
+            m_landComponents.Build(m_mapWidth, m_mapHeight, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, AssetType::LAND_UNIT);
+            });
+
+            SG_ISLANDS_INFO("[Map::GenerateComponents()] Found {} water and {} land regions.",
+                m_waterComponents.GetNumberOfComponents(), m_landComponents.GetNumberOfComponents());
+        }
+
+        /**
+         * @brief Computes the clearance for large units. Must be called after `GenerateMapFields()`.
+         */
+        void GenerateClearance()
+        {
+            m_waterClearance.Build(m_mapWidth, m_mapHeight, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, AssetType::WATER_UNIT);
+            });
+
+            m_landClearance.Build(m_mapWidth, m_mapHeight, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, AssetType::LAND_UNIT);
+            });
+
+            SG_ISLANDS_INFO("[Map::GenerateClearance()] Clearance for large units computed.");
+        }
+
+        /**
+         * @brief Builds the landmark tables that are missing or outdated by a change of the walkability.
+         *        Called once per frame, so several changes in a frame lead to one rebuild.
+         */
+        void UpdateLandmarks()
+        {
+            if (!m_landmarksEnabled)
+            {
+                return;
+            }
+
+            if (!m_waterLandmarks || m_waterLandmarksOutdated)
+            {
+                m_waterLandmarks = CreateLandmarkTable(AssetType::WATER_UNIT);
+                m_waterLandmarksOutdated = false;
+            }
+
+            if (!m_landLandmarks || m_landLandmarksOutdated)
+            {
+                m_landLandmarks = CreateLandmarkTable(AssetType::LAND_UNIT);
+                m_landLandmarksOutdated = false;
+            }
+        }
+
+        /**
+         * @brief Moves the deep water.
+         * @param t_dt The delta time.
+         */
+        void UpdateDeepWater(const sf::Time& t_dt)
+        {
+            m_deepWater.Update(t_dt);
+        }
+
         //-------------------------------------------------
         // Draw
         //-------------------------------------------------
@@ -245,9 +522,11 @@ namespace sg::islands::iso
             text.setFont(t_fontHolder.GetResource(1));
             text.setCharacterSize(10);
 
-            for (auto y{ 0 }; y < m_mapHeight; ++y)
+            const auto area{ GetVisibleArea(t_window.getView()) };
+
+            for (auto y{ area.top }; y < area.top + area.height; ++y)
             {
-                for (auto x{ 0 }; x < m_mapWidth; ++x)
+                for (auto x{ area.left }; x < area.left + area.width; ++x)
                 {
                     t_tileAtlas.DrawMiscTile(TileAtlas::GRID_TILE, x, y, t_window);
 
@@ -277,9 +556,11 @@ namespace sg::islands::iso
             text.setFont(t_fontHolder.GetResource(1));
             text.setCharacterSize(10);
 
-            for (auto y{ 0 }; y < m_mapHeight; ++y)
+            const auto area{ GetVisibleArea(t_window.getView()) };
+
+            for (auto y{ area.top }; y < area.top + area.height; ++y)
             {
-                for (auto x{ 0 }; x < m_mapWidth; ++x)
+                for (auto x{ area.left }; x < area.left + area.width; ++x)
                 {
                     t_tileAtlas.DrawMiscTile(TileAtlas::GRID_TILE, x, y, t_window);
 
@@ -299,22 +580,22 @@ namespace sg::islands::iso
             }
         }
 
+        /**
+         * @brief Draws the deep water as one quad and the visible chunks of the `Island`s. Each chunk is
+         *        drawn from its pre-rendered image in the `TerrainChunkCache`.
+         * @param t_window Reference to the `RenderWindow`.
+         * @param t_tileAtlas The atlas with the tiles.
+         */
         void DrawTerrain(sf::RenderWindow& t_window, const TileAtlas& t_tileAtlas)
         {
-            // draw deep water background
-            for (auto y{ 0 }; y < m_deepWaterHeight; ++y)
-            {
-                for (auto x{ 0 }; x < m_deepWaterWidth; ++x)
-                {
-                    t_tileAtlas.DrawBackgroundTile(x, y, t_window);
-                }
-            }
+            m_deepWater.Draw(t_window, t_tileAtlas);
 
-            // draw `Island`s
-            for (const auto& island : m_islands)
+            m_terrainChunkCache.BeginFrame();
+            m_terrainMesh.ForEachChunk(m_fields, t_tileAtlas, GetVisibleArea(t_window.getView()),
+                [this, &t_window, &t_tileAtlas](const std::size_t t_chunkIndex, const TerrainMesh::Chunk& t_chunk)
             {
-                island->DrawIsland(t_window, t_tileAtlas);
-            }
+                m_terrainChunkCache.Draw(t_window, t_chunkIndex, t_chunk, t_tileAtlas);
+            });
         }
 
     protected:
@@ -346,15 +627,151 @@ namespace sg::islands::iso
         Islands m_islands;
 
         /**
-         * @brief Stores informations about the terrain.
+         * @brief Stores informations about the terrain and the `Asset`s.
+         */
+        MapFieldChunks m_fields;
+
+        /**
+         * @brief The vertices of the terrain, built from `m_fields`.
+         */
+        TerrainMesh m_terrainMesh;
+
+        /**
+         * @brief The pre-rendered images of the terrain chunks.
+         */
+        TerrainChunkCache m_terrainChunkCache;
+
+        /**
+         * @brief The deep water background.
+         */
+        DeepWater m_deepWater;
+
+        /**
+         * @brief The connected regions for `WATER_UNIT`s.
          */
-        MapFields m_mapFields;
+        ConnectedComponents m_waterComponents;
+
+        /**
+         * @brief The connected regions for `LAND_UNIT`s.
+         */
+        ConnectedComponents m_landComponents;
+
+        /**
+         * @brief The clearance for `WATER_UNIT`s.
+         */
+        ClearanceMap m_waterClearance;
+
+        /**
+         * @brief The clearance for `LAND_UNIT`s.
+         */
+        ClearanceMap m_landClearance;
+
+        /**
+         * @brief The landmark distances for `WATER_UNIT`s and `LAND_UNIT`s.
+         *        The tables are shared with the `WalkabilitySnapshot`s of the worker threads.
+         */
+        LandmarkTableSharedPtr m_waterLandmarks;
+        LandmarkTableSharedPtr m_landLandmarks;
+
+        bool m_landmarksEnabled{ false };
+        bool m_waterLandmarksOutdated{ false };
+        bool m_landLandmarksOutdated{ false };
+
+        /**
+         * @brief Functions to call when a map field has changed.
+         */
+        MapChangeListeners m_changeListeners;
+
+        /**
+         * @brief Incremented with each change of the walkability of a map field.
+         */
+        std::uint32_t m_version{ 0 };
+
+        //-------------------------------------------------
+        // Update
+        //-------------------------------------------------
+
+        /**
+         * @brief The walkability of a map field for each type of unit, one bit each.
+         */
+        int GetWalkability(const int t_mapX, const int t_mapY) const
+        {
+            return (IsWalkable(t_mapX, t_mapY, AssetType::WATER_UNIT) ? 1 : 0) |
+                   (IsWalkable(t_mapX, t_mapY, AssetType::LAND_UNIT) ? 2 : 0);
+        }
+
+        /**
+         * @brief Keeps the derived data up to date after a map field has changed.
+         *        The version and the listeners are left alone if the walkability is the same as before.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_walkability The walkability before the change from `GetWalkability()`.
+         */
+        void UpdateMapField(const int t_mapX, const int t_mapY, const int t_walkability)
+        {
+            if (GetWalkability(t_mapX, t_mapY) == t_walkability)
+            {
+                return;
+            }
+
+            m_waterComponents.Update(t_mapX, t_mapY, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, AssetType::WATER_UNIT);
+            });
+
+            m_landComponents.Update(t_mapX, t_mapY, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, AssetType::LAND_UNIT);
+            });
+
+            m_waterClearance.Update(t_mapX, t_mapY, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, AssetType::WATER_UNIT);
+            });
+
+            m_landClearance.Update(t_mapX, t_mapY, [this](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, AssetType::LAND_UNIT);
+            });
+
+            // the distances only change with the walkability
+            if (m_waterLandmarks && m_waterLandmarks->WasWalkable(t_mapX, t_mapY) != IsWalkable(t_mapX, t_mapY, AssetType::WATER_UNIT))
+            {
+                m_waterLandmarksOutdated = true;
+            }
+
+            if (m_landLandmarks && m_landLandmarks->WasWalkable(t_mapX, t_mapY) != IsWalkable(t_mapX, t_mapY, AssetType::LAND_UNIT))
+            {
+                m_landLandmarksOutdated = true;
+            }
+
+            m_version++;
+
+            for (const auto& listener : m_changeListeners)
+            {
+                listener(t_mapX, t_mapY);
+            }
+        }
+
+        LandmarkTableSharedPtr CreateLandmarkTable(const AssetType t_assetType) const
+        {
+            auto landmarks{ std::make_shared<LandmarkTable>() };
+
+            landmarks->Build(m_mapWidth, m_mapHeight, LandmarkTable::DEFAULT_NUMBER_OF_LANDMARKS, [this, t_assetType](const int t_x, const int t_y)
+            {
+                return IsWalkable(t_x, t_y, t_assetType);
+            });
+
+            SG_ISLANDS_INFO("[Map::CreateLandmarkTable()] {} landmarks placed.", landmarks->GetNumberOfLandmarks());
+
+            return landmarks;
+        }
 
         //-------------------------------------------------
         // Load Data
         //-------------------------------------------------
 
-        void LoadMapFile(const core::Filename& t_filename)
+        void LoadMapFile(const core::Filename& t_filename, core::ThreadPool* const t_threadPool)
         {
             SG_ISLANDS_INFO("[Map::LoadMapFile()] Open {} for reading map islands.", t_filename);
 
@@ -370,19 +787,14 @@ namespace sg::islands::iso
             core::XmlWrapper::QueryAttribute(mapElement, "deep_water_width", &m_deepWaterWidth);
             core::XmlWrapper::QueryAttribute(mapElement, "deep_water_height", &m_deepWaterHeight);
 
-            // The tile for deep water is 10 times larger than a standard tile.
-            // The size of the map is converted here to the width and height in default tiles.
-            m_mapWidth = m_deepWaterWidth * IsoMath::DEEP_WATER_TILE_WIDTH / IsoMath::DEFAULT_TILE_WIDTH;
-            m_mapHeight = m_deepWaterHeight * IsoMath::DEEP_WATER_TILE_HEIGHT / IsoMath::DEFAULT_TILE_HEIGHT;
-
-            SG_ISLANDS_INFO("[Map::LoadMapFile()] Map width in deep water tiles: {} ", m_deepWaterWidth);
-            SG_ISLANDS_INFO("[Map::LoadMapFile()] Map height in deep water tiles: {} ", m_deepWaterHeight);
-            SG_ISLANDS_INFO("[Map::LoadMapFile()] Map width in default tiles: {} ", m_mapWidth);
-            SG_ISLANDS_INFO("[Map::LoadMapFile()] Map height in default tiles: {} ", m_mapHeight);
+            InitMapSize();
 
             // get `<islands>` element
             const auto islands{ core::XmlWrapper::GetFirstChildElement(mapElement, "islands") };
 
+            // the island files are independent of each other and are read at the same time
+            std::vector<std::future<IslandUniquePtr>> islandFutures;
+
             // get each island
             for (auto island{ islands->FirstChildElement("island") }; island != nullptr; island = island->NextSiblingElement())
             {
@@ -396,19 +808,94 @@ namespace sg::islands::iso
                 // read path to the island xml file
                 const auto filename{ core::XmlWrapper::GetStringFromXmlElement(island, "filename") };
 
-                // create `Island`
-                auto islandUniquePtr{ std::make_unique<Island>(filename) };
-                assert(islandUniquePtr);
+                islandFutures.push_back(core::ThreadPool::EnqueueOrDefer(t_threadPool, [filename, xMapPosAttr, yMapPosAttr]()
+                {
+                    // create `Island`
+                    auto islandUniquePtr{ std::make_unique<Island>(filename) };
+                    assert(islandUniquePtr);
 
-                // set the map position of the island
-                islandUniquePtr->SetXOffset(xMapPosAttr);
-                islandUniquePtr->SetYOffset(yMapPosAttr);
+                    // set the map position of the island
+                    islandUniquePtr->SetXOffset(xMapPosAttr);
+                    islandUniquePtr->SetYOffset(yMapPosAttr);
 
-                // save `Island`
-                m_islands.push_back(std::move(islandUniquePtr));
+                    return islandUniquePtr;
+                }));
+            }
+
+            // save each `Island` in the order of the map file
+            m_islands.reserve(islandFutures.size());
+            for (auto& islandFuture : islandFutures)
+            {
+                m_islands.push_back(islandFuture.get());
             }
 
             SG_ISLANDS_INFO("[Map::LoadMapFile()] Successfully loaded {} islands.", m_islands.size());
         }
+
+        /**
+         * @brief Loads a map compiled by the map compiler. The file is mapped into memory and
+         *        the tile ids of each `Island` are copied from there; nothing is parsed.
+         */
+        void LoadCompiledMapFile(const core::Filename& t_filename)
+        {
+            SG_ISLANDS_INFO("[Map::LoadCompiledMapFile()] Map {} into memory.", t_filename);
+
+            const core::MappedFile file{ t_filename };
+            const MapFileView view{ file };
+
+            m_deepWaterWidth = view.GetHeader().deepWaterWidth;
+            m_deepWaterHeight = view.GetHeader().deepWaterHeight;
+
+            // the size in default tiles has to fit into an int
+            constexpr auto maxDeepWaterWidth{ std::numeric_limits<int>::max() / IsoMath::DEEP_WATER_TILE_WIDTH };
+            constexpr auto maxDeepWaterHeight{ std::numeric_limits<int>::max() / IsoMath::DEEP_WATER_TILE_HEIGHT };
+            if (m_deepWaterWidth <= 0 || m_deepWaterHeight <= 0 ||
+                m_deepWaterWidth > maxDeepWaterWidth || m_deepWaterHeight > maxDeepWaterHeight)
+            {
+                THROW_SG_EXCEPTION("[Map::LoadCompiledMapFile()] Invalid map size.");
+            }
+
+            InitMapSize();
+
+            m_islands.reserve(view.GetNumberOfIslands());
+
+            for (auto i{ 0 }; i < view.GetNumberOfIslands(); ++i)
+            {
+                const auto& islandEntry{ view.GetIsland(i) };
+
+                // the sizes are positive (see MapFileView::Validate()), so the differences cannot overflow
+                if (islandEntry.xMapPos < 0 || islandEntry.yMapPos < 0 ||
+                    islandEntry.xMapPos > m_mapWidth - islandEntry.width ||
+                    islandEntry.yMapPos > m_mapHeight - islandEntry.height)
+                {
+                    THROW_SG_EXCEPTION("[Map::LoadCompiledMapFile()] Island " + std::to_string(i) + " is outside the map.");
+                }
+
+                auto islandUniquePtr{ std::make_unique<Island>(islandEntry.width, islandEntry.height, view.GetTileIds(i)) };
+
+                islandUniquePtr->SetXOffset(islandEntry.xMapPos);
+                islandUniquePtr->SetYOffset(islandEntry.yMapPos);
+
+                m_islands.push_back(std::move(islandUniquePtr));
+            }
+
+            SG_ISLANDS_INFO("[Map::LoadCompiledMapFile()] Successfully loaded {} islands.", m_islands.size());
+        }
+
+        /**
+         * @brief Converts the size of the map from deep water tiles to default tiles.
+         */
+        void InitMapSize()
+        {
+            // The tile for deep water is 10 times larger than a standard tile.
+            // The size of the map is converted here to the width and height in default tiles.
+            m_mapWidth = m_deepWaterWidth * IsoMath::DEEP_WATER_TILE_WIDTH / IsoMath::DEFAULT_TILE_WIDTH;
+            m_mapHeight = m_deepWaterHeight * IsoMath::DEEP_WATER_TILE_HEIGHT / IsoMath::DEFAULT_TILE_HEIGHT;
+
+            SG_ISLANDS_INFO("[Map::InitMapSize()] Map width in deep water tiles: {} ", m_deepWaterWidth);
+            SG_ISLANDS_INFO("[Map::InitMapSize()] Map height in deep water tiles: {} ", m_deepWaterHeight);
+            SG_ISLANDS_INFO("[Map::InitMapSize()] Map width in default tiles: {} ", m_mapWidth);
+            SG_ISLANDS_INFO("[Map::InitMapSize()] Map height in default tiles: {} ", m_mapHeight);
+        }
     };
 }
@@ -0,0 +1,303 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: MapFieldChunks.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../core/Types.hpp"
+#include "Asset.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief 32 x 32 map fields. Each row of a chunk is a word of bits, one for each field.
+     */
+    struct MapChunk
+    {
+        using Row = std::uint32_t;
+
+        static constexpr int SIZE{ 32 };
+        static constexpr int NUMBER_OF_FIELDS{ SIZE * SIZE };
+
+        std::array<Row, SIZE> land;
+        std::array<Row, SIZE> passable;
+
+        /**
+         * @brief Derived from the land and passable bits.
+         */
+        std::array<Row, SIZE> waterWalkable;
+        std::array<Row, SIZE> landWalkable;
+
+        std::array<core::TileId, NUMBER_OF_FIELDS> terrainTileIds;
+        std::array<AssetId, NUMBER_OF_FIELDS> assetIds;
+    };
+
+    using MapChunkSharedPtr = std::shared_ptr<MapChunk>;
+
+    /**
+     * @brief The map fields in chunks. At first all chunks share one passable deep water chunk;
+     *        a chunk is only copied when one of its fields is changed, so the memory grows with
+     *        the land area and not with the map area.
+     *        A copy of `MapFieldChunks` shares all chunks and costs one pointer per chunk. The shared
+     *        chunks are never changed again: after a copy was made, each chunk is copied before its
+     *        next change, so another thread can read the copy without a lock.
+     *        A `MapFieldChunks` must be copied in the thread that changes it.
+     *        The getters do not check the map bounds.
+     */
+    class MapFieldChunks
+    {
+    public:
+        static constexpr AssetId NO_ASSET{ -1 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        MapFieldChunks() = default;
+
+        /**
+         * @brief Shares the chunks of another `MapFieldChunks`; from now on, both copy a chunk before changing it.
+         * @param t_other The map fields to share.
+         */
+        MapFieldChunks(const MapFieldChunks& t_other)
+            : m_chunksX{ t_other.m_chunksX }
+            , m_chunksY{ t_other.m_chunksY }
+            , m_deepWaterChunk{ t_other.m_deepWaterChunk }
+            , m_chunks{ t_other.m_chunks }
+            , m_chunkEpochs(t_other.m_chunkEpochs.size(), 0)
+            , m_epoch{ ++t_other.m_epoch }
+        {}
+
+        MapFieldChunks(MapFieldChunks&& t_other) noexcept = default;
+        MapFieldChunks& operator=(const MapFieldChunks& t_other) = delete;
+        MapFieldChunks& operator=(MapFieldChunks&& t_other) noexcept = default;
+
+        ~MapFieldChunks() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        bool IsLand(const int t_mapX, const int t_mapY) const
+        {
+            return GetBit(GetChunk(t_mapX, t_mapY).land, t_mapX, t_mapY);
+        }
+
+        bool IsPassable(const int t_mapX, const int t_mapY) const
+        {
+            return GetBit(GetChunk(t_mapX, t_mapY).passable, t_mapX, t_mapY);
+        }
+
+        /**
+         * @brief Checks if a unit of the given type can enter a map field.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return bool
+         */
+        bool IsWalkable(const int t_mapX, const int t_mapY, const AssetType t_assetType) const
+        {
+            assert(t_assetType == AssetType::WATER_UNIT || t_assetType == AssetType::LAND_UNIT);
+
+            const auto& chunk{ GetChunk(t_mapX, t_mapY) };
+
+            return GetBit(t_assetType == AssetType::WATER_UNIT ? chunk.waterWalkable : chunk.landWalkable, t_mapX, t_mapY);
+        }
+
+        core::TileId GetTerrainTileId(const int t_mapX, const int t_mapY) const
+        {
+            return GetChunk(t_mapX, t_mapY).terrainTileIds[GetFieldIndex(t_mapX, t_mapY)];
+        }
+
+        AssetId GetAssetId(const int t_mapX, const int t_mapY) const
+        {
+            return GetChunk(t_mapX, t_mapY).assetIds[GetFieldIndex(t_mapX, t_mapY)];
+        }
+
+        std::size_t GetNumberOfChunks() const noexcept { return m_chunks.size(); }
+
+        /**
+         * @brief Get the number of chunks with own memory.
+         * @return std::size_t
+         */
+        std::size_t GetNumberOfMaterializedChunks() const
+        {
+            std::size_t count{ 0 };
+
+            for (const auto& chunk : m_chunks)
+            {
+                count += chunk != m_deepWaterChunk ? 1 : 0;
+            }
+
+            return count;
+        }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates the chunks for the given size; all fields are passable deep water.
+         * @param t_width The map width.
+         * @param t_height The map height.
+         */
+        void Resize(const int t_width, const int t_height)
+        {
+            m_chunksX = (t_width + MapChunk::SIZE - 1) / MapChunk::SIZE;
+            m_chunksY = (t_height + MapChunk::SIZE - 1) / MapChunk::SIZE;
+
+            m_deepWaterChunk = std::make_shared<MapChunk>();
+            m_deepWaterChunk->land.fill(0);
+            m_deepWaterChunk->passable.fill(~MapChunk::Row{ 0 });
+            m_deepWaterChunk->waterWalkable.fill(~MapChunk::Row{ 0 });
+            m_deepWaterChunk->landWalkable.fill(0);
+            m_deepWaterChunk->terrainTileIds.fill(-1);
+            m_deepWaterChunk->assetIds.fill(NO_ASSET);
+
+            m_chunks.assign(static_cast<std::size_t>(m_chunksX * m_chunksY), m_deepWaterChunk);
+
+            // no chunk is owned yet
+            m_chunkEpochs.assign(m_chunks.size(), 0);
+            m_epoch = 1;
+        }
+
+        /**
+         * @brief Makes a map field a land field.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_terrainTileId The terrain tile.
+         */
+        void SetLand(const int t_mapX, const int t_mapY, const core::TileId t_terrainTileId)
+        {
+            auto& chunk{ GetMutableChunk(t_mapX, t_mapY) };
+
+            SetBit(chunk.land, t_mapX, t_mapY, true);
+            chunk.terrainTileIds[GetFieldIndex(t_mapX, t_mapY)] = t_terrainTileId;
+
+            UpdateWalkability(chunk, t_mapY % MapChunk::SIZE);
+        }
+
+        void SetPassable(const int t_mapX, const int t_mapY, const bool t_passable)
+        {
+            if (IsPassable(t_mapX, t_mapY) == t_passable)
+            {
+                return;
+            }
+
+            auto& chunk{ GetMutableChunk(t_mapX, t_mapY) };
+
+            SetBit(chunk.passable, t_mapX, t_mapY, t_passable);
+
+            UpdateWalkability(chunk, t_mapY % MapChunk::SIZE);
+        }
+
+        void SetAssetId(const int t_mapX, const int t_mapY, const AssetId t_assetId)
+        {
+            if (GetAssetId(t_mapX, t_mapY) == t_assetId)
+            {
+                return;
+            }
+
+            GetMutableChunk(t_mapX, t_mapY).assetIds[GetFieldIndex(t_mapX, t_mapY)] = t_assetId;
+        }
+
+    protected:
+
+    private:
+        int m_chunksX{ 0 };
+        int m_chunksY{ 0 };
+
+        /**
+         * @brief The chunk shared by all untouched chunks.
+         */
+        MapChunkSharedPtr m_deepWaterChunk;
+
+        /**
+         * @brief The chunks row by row.
+         */
+        std::vector<MapChunkSharedPtr> m_chunks;
+
+        /**
+         * @brief For each chunk, the epoch in which it was copied for changes; zero if it was never copied.
+         */
+        std::vector<std::uint32_t> m_chunkEpochs;
+
+        /**
+         * @brief Incremented with each copy of the map fields. A chunk copied in an older epoch may be
+         *        shared and must be copied again before a change.
+         */
+        mutable std::uint32_t m_epoch{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        static int GetFieldIndex(const int t_mapX, const int t_mapY)
+        {
+            return t_mapY % MapChunk::SIZE * MapChunk::SIZE + t_mapX % MapChunk::SIZE;
+        }
+
+        static bool GetBit(const std::array<MapChunk::Row, MapChunk::SIZE>& t_rows, const int t_mapX, const int t_mapY)
+        {
+            return (t_rows[t_mapY % MapChunk::SIZE] >> (t_mapX % MapChunk::SIZE) & 1) != 0;
+        }
+
+        static void SetBit(std::array<MapChunk::Row, MapChunk::SIZE>& t_rows, const int t_mapX, const int t_mapY, const bool t_value)
+        {
+            const auto mask{ MapChunk::Row{ 1 } << t_mapX % MapChunk::SIZE };
+            auto& row{ t_rows[t_mapY % MapChunk::SIZE] };
+
+            row = t_value ? row | mask : row & ~mask;
+        }
+
+        /**
+         * @brief Derives the walkability of a row of 32 map fields at once.
+         */
+        static void UpdateWalkability(MapChunk& t_chunk, const int t_row)
+        {
+            t_chunk.waterWalkable[t_row] = ~t_chunk.land[t_row] & t_chunk.passable[t_row];
+            t_chunk.landWalkable[t_row] = t_chunk.land[t_row] & t_chunk.passable[t_row];
+        }
+
+        const MapChunk& GetChunk(const int t_mapX, const int t_mapY) const
+        {
+            assert(t_mapX >= 0 && t_mapY >= 0 && t_mapX / MapChunk::SIZE < m_chunksX && t_mapY / MapChunk::SIZE < m_chunksY);
+
+            return *m_chunks[static_cast<std::size_t>(t_mapY / MapChunk::SIZE * m_chunksX + t_mapX / MapChunk::SIZE)];
+        }
+
+        /**
+         * @brief Copies a chunk before it is changed, unless it was already copied after the last copy
+         *        of the map fields. The reference count is not used, because other threads release
+         *        their copies at the same time.
+         */
+        MapChunk& GetMutableChunk(const int t_mapX, const int t_mapY)
+        {
+            assert(t_mapX >= 0 && t_mapY >= 0 && t_mapX / MapChunk::SIZE < m_chunksX && t_mapY / MapChunk::SIZE < m_chunksY);
+
+            const auto chunkIndex{ static_cast<std::size_t>(t_mapY / MapChunk::SIZE * m_chunksX + t_mapX / MapChunk::SIZE) };
+            auto& chunk{ m_chunks[chunkIndex] };
+
+            // the deep water chunk is never owned, so it is always copied
+            if (m_chunkEpochs[chunkIndex] != m_epoch)
+            {
+                chunk = std::make_shared<MapChunk>(*chunk);
+                m_chunkEpochs[chunkIndex] = m_epoch;
+            }
+
+            return *chunk;
+        }
+    };
+}
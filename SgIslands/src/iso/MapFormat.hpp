@@ -0,0 +1,236 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: MapFormat.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../core/MappedFile.hpp"
+#include "../core/Types.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief The compiled binary map: a header, a table with one entry per island and the tile ids
+     *        of each island as raw int32 arrays, all in the byte order of the machine.
+     *        Each tile array starts at an offset divisible by 4, so it can be read in place.
+     */
+    struct MapFileHeader
+    {
+        static constexpr char MAGIC[4]{ 'S', 'G', 'M', 'P' };
+        static constexpr std::uint32_t VERSION{ 1 };
+
+        char magic[4];
+        std::uint32_t version;
+        std::int32_t deepWaterWidth;
+        std::int32_t deepWaterHeight;
+        std::uint32_t numberOfIslands;
+        std::uint32_t reserved;
+    };
+
+    struct MapFileIsland
+    {
+        std::int32_t xMapPos;
+        std::int32_t yMapPos;
+        std::int32_t width;
+        std::int32_t height;
+
+        /**
+         * @brief The position of the tile ids from the start of the file in bytes.
+         */
+        std::uint64_t tileIdsOffset;
+    };
+
+    static_assert(std::is_trivially_copyable_v<MapFileHeader> && sizeof(MapFileHeader) == 24);
+    static_assert(std::is_trivially_copyable_v<MapFileIsland> && sizeof(MapFileIsland) == 24);
+    static_assert(sizeof(core::TileId) == sizeof(std::int32_t));
+
+    /**
+     * @brief An island of `MapFileIsland` to write.
+     */
+    struct MapFileIslandData
+    {
+        int xMapPos{ 0 };
+        int yMapPos{ 0 };
+        int width{ 0 };
+        int height{ 0 };
+        std::vector<core::TileId> tileIds;
+    };
+
+    class MapFormat
+    {
+    public:
+        static constexpr auto FILE_EXTENSION{ ".sgmap" };
+
+        /**
+         * @brief Checks if a file is a compiled map by its extension.
+         * @param t_filename The file name.
+         * @return bool
+         */
+        static bool IsCompiledMap(const core::Filename& t_filename)
+        {
+            const std::string extension{ FILE_EXTENSION };
+
+            return t_filename.size() > extension.size() &&
+                t_filename.compare(t_filename.size() - extension.size(), extension.size(), extension) == 0;
+        }
+
+        /**
+         * @brief Writes a compiled map.
+         * @param t_filename The file to write.
+         * @param t_deepWaterWidth The `Map` width in deep water tiles.
+         * @param t_deepWaterHeight The `Map` height in deep water tiles.
+         * @param t_islands The islands with their map positions.
+         */
+        static void Write(
+            const core::Filename& t_filename,
+            const int t_deepWaterWidth,
+            const int t_deepWaterHeight,
+            const std::vector<MapFileIslandData>& t_islands
+        )
+        {
+            MapFileHeader header{};
+            std::memcpy(header.magic, MapFileHeader::MAGIC, sizeof(header.magic));
+            header.version = MapFileHeader::VERSION;
+            header.deepWaterWidth = t_deepWaterWidth;
+            header.deepWaterHeight = t_deepWaterHeight;
+            header.numberOfIslands = static_cast<std::uint32_t>(t_islands.size());
+
+            std::vector<MapFileIsland> table;
+            auto offset{ static_cast<std::uint64_t>(sizeof(MapFileHeader) + t_islands.size() * sizeof(MapFileIsland)) };
+
+            for (const auto& island : t_islands)
+            {
+                if (island.width <= 0 || island.height <= 0 || island.tileIds.size() != static_cast<std::size_t>(island.width * island.height))
+                {
+                    THROW_SG_EXCEPTION("[MapFormat::Write()] Invalid island size.");
+                }
+
+                table.push_back({ island.xMapPos, island.yMapPos, island.width, island.height, offset });
+                offset += island.tileIds.size() * sizeof(core::TileId);
+            }
+
+            std::ofstream file{ t_filename, std::ios::binary | std::ios::trunc };
+            if (!file)
+            {
+                THROW_SG_EXCEPTION("[MapFormat::Write()] Error while opening file " + t_filename);
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(MapFileIsland)));
+
+            for (const auto& island : t_islands)
+            {
+                file.write(reinterpret_cast<const char*>(island.tileIds.data()), static_cast<std::streamsize>(island.tileIds.size() * sizeof(core::TileId)));
+            }
+
+            if (!file)
+            {
+                THROW_SG_EXCEPTION("[MapFormat::Write()] Error while writing file " + t_filename);
+            }
+        }
+    };
+
+    /**
+     * @brief Reads a compiled map in place. All sizes and offsets are checked once, then
+     *        the header, the island table and the tile ids are pointers into the mapped file.
+     */
+    class MapFileView
+    {
+    public:
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        MapFileView() = delete;
+
+        explicit MapFileView(const core::MappedFile& t_file)
+            : m_data{ t_file.GetData() }
+            , m_size{ t_file.GetSize() }
+        {
+            Validate();
+        }
+
+        MapFileView(const MapFileView& t_other) = delete;
+        MapFileView(MapFileView&& t_other) noexcept = delete;
+        MapFileView& operator=(const MapFileView& t_other) = delete;
+        MapFileView& operator=(MapFileView&& t_other) noexcept = delete;
+
+        ~MapFileView() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        const MapFileHeader& GetHeader() const { return *reinterpret_cast<const MapFileHeader*>(m_data); }
+
+        int GetNumberOfIslands() const { return static_cast<int>(GetHeader().numberOfIslands); }
+
+        const MapFileIsland& GetIsland(const int t_island) const
+        {
+            return reinterpret_cast<const MapFileIsland*>(m_data + sizeof(MapFileHeader))[t_island];
+        }
+
+        /**
+         * @brief Get the tile ids of an island, row by row.
+         * @param t_island The index of the island.
+         * @return const core::TileId* `width * height` values.
+         */
+        const core::TileId* GetTileIds(const int t_island) const
+        {
+            return reinterpret_cast<const core::TileId*>(m_data + GetIsland(t_island).tileIdsOffset);
+        }
+
+    protected:
+
+    private:
+        const std::byte* m_data{ nullptr };
+        std::size_t m_size{ 0 };
+
+        void Validate() const
+        {
+            if (m_size < sizeof(MapFileHeader) || std::memcmp(GetHeader().magic, MapFileHeader::MAGIC, sizeof(MapFileHeader::MAGIC)) != 0)
+            {
+                THROW_SG_EXCEPTION("[MapFileView::Validate()] Not a compiled map.");
+            }
+
+            if (GetHeader().version != MapFileHeader::VERSION)
+            {
+                THROW_SG_EXCEPTION("[MapFileView::Validate()] Unsupported map version " + std::to_string(GetHeader().version) + ".");
+            }
+
+            const auto tableEnd{ sizeof(MapFileHeader) + static_cast<std::uint64_t>(GetHeader().numberOfIslands) * sizeof(MapFileIsland) };
+            if (tableEnd > m_size)
+            {
+                THROW_SG_EXCEPTION("[MapFileView::Validate()] The island table is truncated.");
+            }
+
+            for (auto i{ 0 }; i < GetNumberOfIslands(); ++i)
+            {
+                const auto& island{ GetIsland(i) };
+
+                // the offset is checked first, so that the remaining size cannot wrap around
+                if (island.width <= 0 || island.height <= 0 ||
+                    island.tileIdsOffset < tableEnd ||
+                    island.tileIdsOffset > m_size ||
+                    island.tileIdsOffset % alignof(core::TileId) != 0 ||
+                    static_cast<std::uint64_t>(island.width) * static_cast<std::uint64_t>(island.height) > (m_size - island.tileIdsOffset) / sizeof(core::TileId))
+                {
+                    THROW_SG_EXCEPTION("[MapFileView::Validate()] Invalid island " + std::to_string(i) + ".");
+                }
+            }
+        }
+    };
+}
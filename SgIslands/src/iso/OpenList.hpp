@@ -0,0 +1,276 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: OpenList.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include "PagedCells.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief An indexed binary min-heap used as open list by the pathfinding.
+     *        Every map cell has a slot in a position index, so a cell can be found in O(1)
+     *        and its key can be decreased in O(log n) instead of pushing duplicates.
+     *        The position index is kept in `PagedCells`, so it only takes memory where cells were pushed.
+     *        Entries with the same f-value are returned in the order they were pushed or updated.
+     */
+    class OpenList
+    {
+    public:
+        using CellIndex = int;
+
+        static constexpr auto NOT_IN_LIST{ -1 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        OpenList() = default;
+
+        OpenList(const OpenList& t_other) = delete;
+        OpenList(OpenList&& t_other) noexcept = delete;
+        OpenList& operator=(const OpenList& t_other) = delete;
+        OpenList& operator=(OpenList&& t_other) noexcept = delete;
+
+        ~OpenList() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Checks if the open list is empty.
+         * @return bool
+         */
+        bool IsEmpty() const noexcept { return m_heap.empty(); }
+
+        /**
+         * @brief Returns the number of cells in the open list.
+         * @return std::size_t
+         */
+        std::size_t GetSize() const noexcept { return m_heap.size(); }
+
+        /**
+         * @brief Returns the lowest total cost without removing the cell.
+         * @return float
+         */
+        float GetMinF() const
+        {
+            assert(!m_heap.empty());
+
+            return m_heap.front().f;
+        }
+
+        /**
+         * @brief Checks if a cell is in the open list.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return bool
+         */
+        bool Contains(const CellIndex t_cellIndex) const
+        {
+            const auto* position{ m_positions.Find(t_cellIndex) };
+
+            return position && *position != NOT_IN_LIST;
+        }
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates an empty position index for a map of the given size.
+         * @param t_width The map width.
+         * @param t_height The map height.
+         */
+        void Resize(const int t_width, const int t_height)
+        {
+            m_heap.clear();
+            m_positions.Resize(t_width, t_height, NOT_IN_LIST);
+            m_order = 0;
+        }
+
+        /**
+         * @brief Removes all cells. Only the remaining entries are touched.
+         */
+        void Clear()
+        {
+            for (const auto& entry : m_heap)
+            {
+                *entry.position = NOT_IN_LIST;
+            }
+
+            m_heap.clear();
+            m_order = 0;
+        }
+
+        //-------------------------------------------------
+        // Push && Pop
+        //-------------------------------------------------
+
+        /**
+         * @brief Adds a cell or decreases the key of a cell that is already in the open list.
+         * @param t_cellIndex The 1D index of the cell.
+         * @param t_f The total cost of the cell.
+         */
+        void Push(const CellIndex t_cellIndex, const float t_f)
+        {
+            auto& cellPosition{ m_positions.Get(t_cellIndex) };
+            auto position{ cellPosition };
+
+            if (position == NOT_IN_LIST)
+            {
+                position = static_cast<int>(m_heap.size());
+                m_heap.push_back(Entry{ t_cellIndex, t_f, m_order++, &cellPosition });
+                cellPosition = position;
+            }
+            else
+            {
+                // decrease-key: the key can only get smaller
+                assert(t_f < m_heap[position].f);
+
+                m_heap[position].f = t_f;
+                m_heap[position].order = m_order++;
+            }
+
+            SiftUp(position);
+        }
+
+        /**
+         * @brief Removes and returns the cell with the lowest total cost.
+         * @return CellIndex
+         */
+        CellIndex Pop()
+        {
+            assert(!m_heap.empty());
+
+            const auto cellIndex{ m_heap.front().cellIndex };
+            *m_heap.front().position = NOT_IN_LIST;
+
+            const auto last{ m_heap.back() };
+            m_heap.pop_back();
+
+            if (!m_heap.empty())
+            {
+                m_heap.front() = last;
+                *last.position = 0;
+                SiftDown(0);
+            }
+
+            return cellIndex;
+        }
+
+    protected:
+
+    private:
+        struct Entry
+        {
+            CellIndex cellIndex;
+            float f;
+
+            /**
+             * @brief Push counter to keep the first-in order of equal f-values.
+             */
+            std::uint32_t order;
+
+            /**
+             * @brief The slot of the cell in the position index; the pages never move.
+             */
+            int* position;
+        };
+
+        /**
+         * @brief The binary heap.
+         */
+        std::vector<Entry> m_heap;
+
+        /**
+         * @brief The position of each cell in the heap or `NOT_IN_LIST`.
+         */
+        PagedCells<int> m_positions;
+
+        /**
+         * @brief Counts the pushes since the last `Clear()`.
+         */
+        std::uint32_t m_order{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        static bool IsLess(const Entry& t_lhs, const Entry& t_rhs)
+        {
+            if (t_lhs.f != t_rhs.f)
+            {
+                return t_lhs.f < t_rhs.f;
+            }
+
+            return t_lhs.order < t_rhs.order;
+        }
+
+        void Place(const int t_position, const Entry& t_entry)
+        {
+            m_heap[t_position] = t_entry;
+            *t_entry.position = t_position;
+        }
+
+        void SiftUp(int t_position)
+        {
+            const auto entry{ m_heap[t_position] };
+
+            while (t_position > 0)
+            {
+                const auto parent{ (t_position - 1) / 2 };
+                if (!IsLess(entry, m_heap[parent]))
+                {
+                    break;
+                }
+
+                Place(t_position, m_heap[parent]);
+                t_position = parent;
+            }
+
+            Place(t_position, entry);
+        }
+
+        void SiftDown(int t_position)
+        {
+            const auto size{ static_cast<int>(m_heap.size()) };
+            const auto entry{ m_heap[t_position] };
+
+            while (true)
+            {
+                auto child{ 2 * t_position + 1 };
+                if (child >= size)
+                {
+                    break;
+                }
+
+                if (child + 1 < size && IsLess(m_heap[child + 1], m_heap[child]))
+                {
+                    child++;
+                }
+
+                if (!IsLess(m_heap[child], entry))
+                {
+                    break;
+                }
+
+                Place(t_position, m_heap[child]);
+                t_position = child;
+            }
+
+            Place(t_position, entry);
+        }
+    };
+}
@@ -0,0 +1,212 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: PagedCells.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief A value for each map cell, stored in pages of 32 x 32 cells. A page is only
+     *        allocated when one of its cells is written for the first time, so the memory
+     *        grows with the area a search has touched and not with the map area.
+     *        The allocated pages are kept, so later searches in the same area do not allocate.
+     *        The cells are addressed by their 1D index, like in the searches.
+     * @tparam T The value type.
+     */
+    template <typename T>
+    class PagedCells
+    {
+    public:
+        using CellIndex = int;
+
+        static constexpr int PAGE_SIZE{ 32 };
+        static constexpr int CELLS_PER_PAGE{ PAGE_SIZE * PAGE_SIZE };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        PagedCells() = default;
+
+        PagedCells(const PagedCells& t_other) = delete;
+        PagedCells(PagedCells&& t_other) noexcept = delete;
+        PagedCells& operator=(const PagedCells& t_other) = delete;
+        PagedCells& operator=(PagedCells&& t_other) noexcept = delete;
+
+        ~PagedCells() noexcept = default;
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        /**
+         * @brief Releases all pages and sets the size of the map.
+         * @param t_width The map width.
+         * @param t_height The map height.
+         * @param t_value The value of a cell before it is written.
+         */
+        void Resize(const int t_width, const int t_height, const T& t_value)
+        {
+            assert(t_width > 0 && t_height > 0);
+
+            m_width = t_width;
+            m_pagesX = (t_width + PAGE_SIZE - 1) / PAGE_SIZE;
+            m_value = t_value;
+
+            // the row is found with a multiplication: y = index * m_reciprocal >> m_shift,
+            // exact for all 32-bit indices with m_reciprocal = ceil(2^m_shift / width)
+            auto log2Width{ 0 };
+            while ((std::uint64_t{ 1 } << log2Width) < static_cast<std::uint64_t>(t_width))
+            {
+                log2Width++;
+            }
+
+            m_shift = 32 + log2Width;
+            m_reciprocal = ((std::uint64_t{ 1 } << m_shift) + static_cast<std::uint64_t>(t_width) - 1) / static_cast<std::uint64_t>(t_width);
+
+            const auto pagesY{ (t_height + PAGE_SIZE - 1) / PAGE_SIZE };
+
+            m_pages.clear();
+            m_pages.resize(static_cast<std::size_t>(m_pagesX * pagesY));
+
+            m_numberOfCells = static_cast<std::size_t>(t_width) * static_cast<std::size_t>(t_height);
+        }
+
+        /**
+         * @brief Sets all cells of the allocated pages to the value of an unwritten cell.
+         */
+        void Reset()
+        {
+            for (auto& page : m_pages)
+            {
+                if (page)
+                {
+                    page->fill(m_value);
+                }
+            }
+        }
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Returns the number of cells of the map.
+         * @return std::size_t
+         */
+        std::size_t GetSize() const noexcept { return m_numberOfCells; }
+
+        /**
+         * @brief Returns the memory of the allocated pages in bytes.
+         * @return std::size_t
+         */
+        std::size_t GetMemoryUsage() const
+        {
+            std::size_t count{ 0 };
+
+            for (const auto& page : m_pages)
+            {
+                count += page ? 1 : 0;
+            }
+
+            return count * sizeof(Page);
+        }
+
+        /**
+         * @brief Returns a cell without allocating its page.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return Pointer to the cell or nullptr if its page was never written.
+         */
+        const T* Find(const CellIndex t_cellIndex) const
+        {
+            const auto& page{ m_pages[GetPageIndex(t_cellIndex)] };
+
+            return page ? &(*page)[GetOffset(t_cellIndex)] : nullptr;
+        }
+
+        /**
+         * @brief Returns a cell for writing; its page is allocated on first use.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return Reference to the cell
+         */
+        T& Get(const CellIndex t_cellIndex)
+        {
+            auto& page{ m_pages[GetPageIndex(t_cellIndex)] };
+
+            if (!page)
+            {
+                page = std::make_unique<Page>();
+                page->fill(m_value);
+            }
+
+            return (*page)[GetOffset(t_cellIndex)];
+        }
+
+    protected:
+
+    private:
+        using Page = std::array<T, CELLS_PER_PAGE>;
+
+        int m_width{ 0 };
+        int m_pagesX{ 0 };
+
+        /**
+         * @brief Replace the division of a cell index by the map width, which is done for each access.
+         */
+        std::uint64_t m_reciprocal{ 0 };
+        int m_shift{ 0 };
+
+        std::size_t m_numberOfCells{ 0 };
+
+        /**
+         * @brief The value of a cell before it is written.
+         */
+        T m_value{};
+
+        /**
+         * @brief The pages row by row; nullptr until a cell of the page is written.
+         */
+        std::vector<std::unique_ptr<Page>> m_pages;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        int GetY(const CellIndex t_cellIndex) const
+        {
+            assert(t_cellIndex >= 0 && static_cast<std::size_t>(t_cellIndex) < m_numberOfCells);
+
+            return static_cast<int>(static_cast<std::uint64_t>(t_cellIndex) * m_reciprocal >> m_shift);
+        }
+
+        std::size_t GetPageIndex(const CellIndex t_cellIndex) const
+        {
+            const auto y{ GetY(t_cellIndex) };
+            const auto x{ t_cellIndex - y * m_width };
+
+            return static_cast<std::size_t>(y / PAGE_SIZE * m_pagesX + x / PAGE_SIZE);
+        }
+
+        std::size_t GetOffset(const CellIndex t_cellIndex) const
+        {
+            const auto y{ GetY(t_cellIndex) };
+            const auto x{ t_cellIndex - y * m_width };
+
+            return static_cast<std::size_t>(y % PAGE_SIZE * PAGE_SIZE + x % PAGE_SIZE);
+        }
+    };
+}
@@ -0,0 +1,266 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: PathRequestQueue.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "../core/ThreadPool.hpp"
+#include "GridSearch.hpp"
+#include "PathSmoother.hpp"
+#include "WalkabilitySnapshot.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief Identifies a path request. Zero is never used.
+     */
+    using PathRequestId = std::uint64_t;
+
+    /**
+     * @brief Identifies the unit that asked for a path, e.g. an entity id.
+     */
+    using PathUnitId = std::uint64_t;
+
+    static constexpr PathRequestId NO_PATH_REQUEST{ 0 };
+
+    struct PathResult
+    {
+        PathUnitId unitId{ 0 };
+        PathRequestId requestId{ NO_PATH_REQUEST };
+        Waypoints path;
+    };
+
+    /**
+     * @brief Solves path requests on worker threads.
+     *        The requests are made and the results are collected in the game thread. The workers
+     *        only see a `WalkabilitySnapshot`, which is renewed when the `Map` has changed.
+     *        Each unit has at most one pending request: a new request cancels the older one.
+     */
+    class PathRequestQueue
+    {
+    public:
+        using SnapshotSharedPtr = std::shared_ptr<const WalkabilitySnapshot>;
+        using GridSearchUniquePtr = std::unique_ptr<GridSearch<WalkabilitySnapshot>>;
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        PathRequestQueue() = delete;
+
+        PathRequestQueue(const Map& t_map, const std::size_t t_numberOfThreads)
+            : m_map{ t_map }
+            , m_threadPool{ t_numberOfThreads }
+        {
+            // one search state per worker; a worker takes one for each request
+            for (std::size_t i{ 0 }; i < m_threadPool.GetNumberOfThreads(); ++i)
+            {
+                m_gridSearches.push_back(std::make_unique<GridSearch<WalkabilitySnapshot>>(m_map.GetMapWidth(), m_map.GetMapHeight()));
+            }
+
+            SG_ISLANDS_INFO("[PathRequestQueue::PathRequestQueue()] Started {} path worker threads.", m_threadPool.GetNumberOfThreads());
+        }
+
+        PathRequestQueue(const PathRequestQueue& t_other) = delete;
+        PathRequestQueue(PathRequestQueue&& t_other) noexcept = delete;
+        PathRequestQueue& operator=(const PathRequestQueue& t_other) = delete;
+        PathRequestQueue& operator=(PathRequestQueue&& t_other) noexcept = delete;
+
+        ~PathRequestQueue() noexcept = default;
+
+        //-------------------------------------------------
+        // Game thread
+        //-------------------------------------------------
+
+        /**
+         * @brief Enqueues a path request. A pending request of the same unit becomes stale.
+         * @param t_unitId The unit that asked for the path.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_algorithm The grid search to run.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return PathRequestId
+         */
+        PathRequestId Request(
+            const PathUnitId t_unitId,
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType t_assetType,
+            const SearchAlgorithm t_algorithm,
+            const int t_footprint = 1
+        )
+        {
+            if (!m_snapshot || m_snapshot->IsOutdated(m_map))
+            {
+                m_snapshot = std::make_shared<const WalkabilitySnapshot>(m_map);
+            }
+
+            PathRequestId requestId;
+
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                requestId = ++m_lastRequestId;
+                m_latestRequests[t_unitId] = requestId;
+            }
+
+            m_threadPool.Enqueue([this, snapshot = m_snapshot, t_unitId, requestId, t_startPosition, t_targetPosition, t_assetType, t_algorithm, t_footprint]()
+            {
+                Solve(*snapshot, t_unitId, requestId, t_startPosition, t_targetPosition, t_assetType, t_algorithm, t_footprint);
+            });
+
+            return requestId;
+        }
+
+        /**
+         * @brief Cancels the pending request of a unit.
+         * @param t_unitId The unit.
+         */
+        void Cancel(const PathUnitId t_unitId)
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_latestRequests.erase(t_unitId);
+        }
+
+        /**
+         * @brief Moves the finished results of the latest requests into the given vector.
+         * @param t_results Receives the results.
+         */
+        void PollResults(std::vector<PathResult>& t_results)
+        {
+            t_results.clear();
+
+            std::lock_guard<std::mutex> lock{ m_mutex };
+
+            for (auto& result : m_results)
+            {
+                if (IsLatest(result.unitId, result.requestId))
+                {
+                    m_latestRequests.erase(result.unitId);
+                    t_results.push_back(std::move(result));
+                }
+            }
+
+            m_results.clear();
+        }
+
+    protected:
+
+    private:
+        /**
+         * @brief Reference to `Map`. Only read in the game thread.
+         */
+        const Map& m_map;
+
+        /**
+         * @brief The snapshot for new requests.
+         */
+        SnapshotSharedPtr m_snapshot;
+
+        /**
+         * @brief Guards all members below.
+         */
+        std::mutex m_mutex;
+
+        PathRequestId m_lastRequestId{ NO_PATH_REQUEST };
+        std::unordered_map<PathUnitId, PathRequestId> m_latestRequests;
+        std::vector<PathResult> m_results;
+        std::vector<GridSearchUniquePtr> m_gridSearches;
+
+        /**
+         * @brief The workers; declared last, so they are joined before the other members are destroyed.
+         */
+        core::ThreadPool m_threadPool;
+
+        //-------------------------------------------------
+        // Worker thread
+        //-------------------------------------------------
+
+        void Solve(
+            const WalkabilitySnapshot& t_snapshot,
+            const PathUnitId t_unitId,
+            const PathRequestId t_requestId,
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType t_assetType,
+            const SearchAlgorithm t_algorithm,
+            const int t_footprint
+        )
+        {
+            GridSearchUniquePtr gridSearch;
+
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+
+                // skip requests that became stale while waiting
+                if (!IsLatest(t_unitId, t_requestId))
+                {
+                    return;
+                }
+
+                assert(!m_gridSearches.empty());
+                gridSearch = std::move(m_gridSearches.back());
+                m_gridSearches.pop_back();
+            }
+
+            PathResult result;
+            result.unitId = t_unitId;
+            result.requestId = t_requestId;
+
+            std::vector<Node> path;
+
+            if (t_algorithm == SearchAlgorithm::JPS)
+            {
+                gridSearch->FindJpsPath(t_snapshot, t_startPosition, t_targetPosition, t_assetType, path, t_footprint);
+            }
+            else if (t_algorithm == SearchAlgorithm::BIDIRECTIONAL)
+            {
+                gridSearch->FindBidirectionalPath(t_snapshot, t_startPosition, t_targetPosition, t_assetType, path, t_footprint);
+            }
+            else
+            {
+                Node startNode;
+                Node endNode;
+
+                startNode.position = t_startPosition;
+                endNode.position = t_targetPosition;
+
+                gridSearch->FindPath(t_snapshot, startNode, endNode, t_assetType, path, t_footprint);
+            }
+
+            // the smoothing also runs in the worker thread
+            PathSmoother::Smooth(t_snapshot, t_assetType, t_footprint, path, result.path);
+
+            std::lock_guard<std::mutex> lock{ m_mutex };
+
+            m_gridSearches.push_back(std::move(gridSearch));
+
+            if (IsLatest(t_unitId, t_requestId))
+            {
+                m_results.push_back(std::move(result));
+            }
+        }
+
+        /**
+         * @brief Checks if a request is the latest of its unit. The caller must hold `m_mutex`.
+         */
+        bool IsLatest(const PathUnitId t_unitId, const PathRequestId t_requestId) const
+        {
+            const auto it{ m_latestRequests.find(t_unitId) };
+
+            return it != m_latestRequests.end() && it->second == t_requestId;
+        }
+    };
+}
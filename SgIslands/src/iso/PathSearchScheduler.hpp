@@ -0,0 +1,302 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: PathSearchScheduler.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include "Map.hpp"
+#include "PathRequestQueue.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief Solves path requests in the game thread, one after the other, in slices.
+     *        Each frame the searches may expand a limited number of nodes and run for a limited time;
+     *        a search that exceeds the budget is resumed in the next frame. So the time spent on
+     *        grid searches per frame does not depend on the number of pending requests.
+     *        The time includes beginning a search and smoothing its path. The jumps of JPS stop at
+     *        the end of a slice, so a frame can only run over by one field per direction of the last
+     *        node and by the smoothing of one path; the overrun is taken from the budget of the next frame.
+     *        Each unit has at most one pending request: a new request cancels the older one.
+     *        Not covered by the budget: the flow fields of groups, hierarchical searches, D* Lite
+     *        replans and the path comparison of the debug Gui. They run in the game thread when
+     *        they are needed.
+     */
+    class PathSearchScheduler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t DEFAULT_MAX_EXPANDED_NODES{ 4000 };
+        static constexpr int DEFAULT_MAX_MICROSECONDS{ 2000 };
+
+        /**
+         * @brief The clock is read after each slice of this many expanded nodes.
+         *        A map field walked over by a jump of a Jump Point Search counts as a node.
+         */
+        static constexpr std::size_t NODES_PER_SLICE{ 64 };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        PathSearchScheduler() = delete;
+
+        explicit PathSearchScheduler(const Map& t_map)
+            : m_map{ t_map }
+            , m_gridSearch{ t_map.GetMapWidth(), t_map.GetMapHeight() }
+        {}
+
+        PathSearchScheduler(const PathSearchScheduler& t_other) = delete;
+        PathSearchScheduler(PathSearchScheduler&& t_other) noexcept = delete;
+        PathSearchScheduler& operator=(const PathSearchScheduler& t_other) = delete;
+        PathSearchScheduler& operator=(PathSearchScheduler&& t_other) noexcept = delete;
+
+        ~PathSearchScheduler() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Checks if the path requests are solved in the game thread instead of the worker threads.
+         * @return bool
+         */
+        bool IsEnabled() const noexcept { return m_enabled; }
+
+        std::size_t GetMaxExpandedNodes() const noexcept { return m_maxExpandedNodes; }
+
+        int GetMaxMicroseconds() const noexcept { return m_maxMicroseconds; }
+
+        std::size_t GetNumberOfPendingSearches() const noexcept { return m_searches.size(); }
+
+        /**
+         * @brief Get the number of nodes expanded in the last frame.
+         * @return std::size_t
+         */
+        std::size_t GetLastExpandedNodes() const noexcept { return m_lastExpandedNodes; }
+
+        /**
+         * @brief Get the time spent on searches in the last frame.
+         * @return double
+         */
+        double GetLastMicroseconds() const noexcept { return m_lastMicroseconds; }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        void SetEnabled(const bool t_enabled) { m_enabled = t_enabled; }
+
+        void SetMaxExpandedNodes(const std::size_t t_maxExpandedNodes) { m_maxExpandedNodes = std::max<std::size_t>(t_maxExpandedNodes, 1); }
+
+        void SetMaxMicroseconds(const int t_maxMicroseconds) { m_maxMicroseconds = std::max(t_maxMicroseconds, 1); }
+
+        //-------------------------------------------------
+        // Requests
+        //-------------------------------------------------
+
+        /**
+         * @brief Enqueues a path request. A pending request of the same unit becomes stale.
+         * @param t_unitId The unit that asked for the path.
+         * @param t_startPosition The start map position.
+         * @param t_targetPosition The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_algorithm The grid search to run.
+         * @param t_footprint The width and height of the unit in map fields.
+         * @return PathRequestId
+         */
+        PathRequestId Request(
+            const PathUnitId t_unitId,
+            const sf::Vector2i& t_startPosition,
+            const sf::Vector2i& t_targetPosition,
+            const AssetType t_assetType,
+            const SearchAlgorithm t_algorithm,
+            const int t_footprint = 1
+        )
+        {
+            const auto requestId{ ++m_lastRequestId };
+
+            m_latestRequests[t_unitId] = requestId;
+            m_searches.push_back({ t_unitId, requestId, t_startPosition, t_targetPosition, t_assetType, t_algorithm, t_footprint });
+
+            return requestId;
+        }
+
+        /**
+         * @brief Cancels the pending request of a unit.
+         * @param t_unitId The unit.
+         */
+        void Cancel(const PathUnitId t_unitId)
+        {
+            m_latestRequests.erase(t_unitId);
+        }
+
+        //-------------------------------------------------
+        // Frame
+        //-------------------------------------------------
+
+        /**
+         * @brief Renews the budget. Called once per rendered frame, so the fixed updates of one frame share the budget.
+         *        What the last frame spent over its budget is taken from the new one.
+         */
+        void BeginFrame()
+        {
+            m_lastExpandedNodes = m_expandedNodes;
+            m_lastMicroseconds = m_microseconds;
+
+            m_expandedNodes = m_expandedNodes > m_maxExpandedNodes ? m_expandedNodes - m_maxExpandedNodes : 0;
+            m_microseconds = std::max(m_microseconds - m_maxMicroseconds, 0.0);
+        }
+
+        /**
+         * @brief Advances the searches until they are finished or the budget of the frame is spent.
+         * @param t_results Receives the results of the finished searches.
+         */
+        void Update(std::vector<PathResult>& t_results)
+        {
+            t_results.clear();
+
+            const auto start{ Clock::now() };
+            auto elapsed{ 0.0 };
+
+            while (!m_searches.empty() &&
+                m_expandedNodes < m_maxExpandedNodes &&
+                m_microseconds + elapsed < m_maxMicroseconds)
+            {
+                const auto& search{ m_searches.front() };
+
+                // skip requests that became stale while waiting
+                if (!IsLatest(search.unitId, search.requestId))
+                {
+                    m_searches.pop_front();
+                    m_searchStarted = false;
+                    continue;
+                }
+
+                // a changed map field may invalidate the nodes closed so far
+                if (!m_searchStarted || m_searchVersion != m_map.GetVersion())
+                {
+                    BeginSearch(search);
+                    m_searchStarted = true;
+                    m_searchVersion = m_map.GetVersion();
+                }
+
+                const auto cost{ m_gridSearch.GetSearchCost() };
+                const auto status{ m_gridSearch.ContinueSearch(std::min(NODES_PER_SLICE, m_maxExpandedNodes - m_expandedNodes)) };
+                m_expandedNodes += m_gridSearch.GetSearchCost() - cost;
+
+                if (status != SearchStatus::SEARCHING)
+                {
+                    PathResult result;
+                    result.unitId = search.unitId;
+                    result.requestId = search.requestId;
+
+                    m_gridSearch.GetPath(m_path);
+                    PathSmoother::Smooth(m_map, search.assetType, search.footprint, m_path, result.path);
+
+                    m_latestRequests.erase(search.unitId);
+                    t_results.push_back(std::move(result));
+
+                    m_searches.pop_front();
+                    m_searchStarted = false;
+                }
+
+                elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            }
+
+            m_microseconds += elapsed;
+        }
+
+    protected:
+
+    private:
+        struct PendingSearch
+        {
+            PathUnitId unitId{ 0 };
+            PathRequestId requestId{ NO_PATH_REQUEST };
+            sf::Vector2i startPosition;
+            sf::Vector2i targetPosition;
+            AssetType assetType{ AssetType::NONE };
+            SearchAlgorithm algorithm{ SearchAlgorithm::ASTAR };
+            int footprint{ 1 };
+        };
+
+        /**
+         * @brief Reference to `Map`.
+         */
+        const Map& m_map;
+
+        /**
+         * @brief The search state of the first pending search; kept between the frames.
+         */
+        GridSearch<Map> m_gridSearch;
+
+        bool m_enabled{ false };
+
+        std::size_t m_maxExpandedNodes{ DEFAULT_MAX_EXPANDED_NODES };
+        int m_maxMicroseconds{ DEFAULT_MAX_MICROSECONDS };
+
+        PathRequestId m_lastRequestId{ NO_PATH_REQUEST };
+
+        /**
+         * @brief The requests in the order they were made.
+         */
+        std::deque<PendingSearch> m_searches;
+        std::unordered_map<PathUnitId, PathRequestId> m_latestRequests;
+
+        /**
+         * @brief True if the first pending search was begun.
+         */
+        bool m_searchStarted{ false };
+
+        /**
+         * @brief The `Map` version the first pending search was begun with.
+         */
+        std::uint32_t m_searchVersion{ 0 };
+
+        /**
+         * @brief The budget spent in the current frame.
+         */
+        std::size_t m_expandedNodes{ 0 };
+        double m_microseconds{ 0.0 };
+
+        std::size_t m_lastExpandedNodes{ 0 };
+        double m_lastMicroseconds{ 0.0 };
+
+        /**
+         * @brief The grid path before smoothing; kept to avoid allocations.
+         */
+        std::vector<Node> m_path;
+
+        void BeginSearch(const PendingSearch& t_search)
+        {
+            if (t_search.algorithm == SearchAlgorithm::BIDIRECTIONAL)
+            {
+                m_gridSearch.BeginBidirectionalSearch(m_map, t_search.startPosition, t_search.targetPosition, t_search.assetType, t_search.footprint);
+                return;
+            }
+
+            m_gridSearch.BeginSearch(m_map, t_search.startPosition, t_search.targetPosition, t_search.assetType, t_search.algorithm == SearchAlgorithm::JPS, t_search.footprint);
+        }
+
+        bool IsLatest(const PathUnitId t_unitId, const PathRequestId t_requestId) const
+        {
+            const auto it{ m_latestRequests.find(t_unitId) };
+
+            return it != m_latestRequests.end() && it->second == t_requestId;
+        }
+    };
+}
@@ -0,0 +1,152 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: PathSmoother.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdlib>
+#include <vector>
+#include "Node.hpp"
+#include "Asset.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief The corners of a path; a unit goes in a straight line from one to the next.
+     */
+    using Waypoints = std::vector<sf::Vector2i>;
+
+    /**
+     * @brief Turns a grid path into a short polyline (string pulling).
+     *        A waypoint is dropped if its predecessor can see its successor.
+     *        `TGrid` needs `IsWalkable(x, y, assetType, footprint)`.
+     */
+    class PathSmoother
+    {
+    public:
+        //-------------------------------------------------
+        // Smooth
+        //-------------------------------------------------
+
+        /**
+         * @brief Checks if all map fields touched by the line between the centers of two map fields are walkable.
+         *        If the line passes exactly through a corner, both map fields beside the corner have to be walkable.
+         * @tparam TGrid `Map` or `WalkabilitySnapshot`.
+         * @param t_grid The walkability.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         * @param t_from The start map position.
+         * @param t_to The end map position.
+         * @return bool
+         */
+        template <typename TGrid>
+        static bool HasLineOfSight(
+            const TGrid& t_grid,
+            const AssetType t_assetType,
+            const int t_footprint,
+            const sf::Vector2i& t_from,
+            const sf::Vector2i& t_to
+        )
+        {
+            const auto nx{ std::abs(t_to.x - t_from.x) };
+            const auto ny{ std::abs(t_to.y - t_from.y) };
+            const auto stepX{ t_to.x > t_from.x ? 1 : -1 };
+            const auto stepY{ t_to.y > t_from.y ? 1 : -1 };
+
+            // the start is not checked; the unit is already there
+            auto x{ t_from.x };
+            auto y{ t_from.y };
+
+            for (auto ix{ 0 }, iy{ 0 }; ix < nx || iy < ny;)
+            {
+                // compares the distances to the next vertical and horizontal cell border
+                const auto decision{ (1 + 2 * ix) * ny - (1 + 2 * iy) * nx };
+
+                if (decision == 0)
+                {
+                    if (!t_grid.IsWalkable(x + stepX, y, t_assetType, t_footprint) ||
+                        !t_grid.IsWalkable(x, y + stepY, t_assetType, t_footprint))
+                    {
+                        return false;
+                    }
+
+                    x += stepX;
+                    y += stepY;
+                    ix++;
+                    iy++;
+                }
+                else if (decision < 0)
+                {
+                    x += stepX;
+                    ix++;
+                }
+                else
+                {
+                    y += stepY;
+                    iy++;
+                }
+
+                if (!t_grid.IsWalkable(x, y, t_assetType, t_footprint))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Removes all waypoints that can be skipped in a straight line.
+         * @tparam TGrid `Map` or `WalkabilitySnapshot`.
+         * @param t_grid The walkability.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields.
+         * @param t_path The grid path; the first node is the start.
+         * @param t_waypoints Receives the start, the remaining corners and the target.
+         */
+        template <typename TGrid>
+        static void Smooth(
+            const TGrid& t_grid,
+            const AssetType t_assetType,
+            const int t_footprint,
+            const std::vector<Node>& t_path,
+            Waypoints& t_waypoints
+        )
+        {
+            t_waypoints.clear();
+
+            if (t_path.empty())
+            {
+                return;
+            }
+
+            t_waypoints.push_back(t_path.front().position);
+
+            for (std::size_t i{ 2 }; i < t_path.size(); ++i)
+            {
+                if (!HasLineOfSight(t_grid, t_assetType, t_footprint, t_waypoints.back(), t_path[i].position))
+                {
+                    t_waypoints.push_back(t_path[i - 1].position);
+                }
+            }
+
+            if (t_path.size() > 1)
+            {
+                t_waypoints.push_back(t_path.back().position);
+            }
+        }
+
+    protected:
+
+    private:
+
+    };
+}
@@ -0,0 +1,256 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: SearchArena.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include "PagedCells.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief Per-cell state of a path search, kept in `PagedCells`: the memory is only allocated
+     *        for the parts of the `Map` a search has touched.
+     *        Instead of resetting all cells before a search, every cell carries the generation
+     *        in which it was written last. A cell with an old generation counts as unvisited,
+     *        so a search only pays for the cells it actually touches.
+     */
+    class SearchArena
+    {
+    public:
+        using CellIndex = int;
+        using Generation = std::uint32_t;
+
+        static constexpr CellIndex NO_PARENT{ -1 };
+
+        enum class CellState : std::uint8_t
+        {
+            UNVISITED,
+            OPEN,
+            CLOSED
+        };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        SearchArena() = default;
+
+        SearchArena(const SearchArena& t_other) = delete;
+        SearchArena(SearchArena&& t_other) noexcept = delete;
+        SearchArena& operator=(const SearchArena& t_other) = delete;
+        SearchArena& operator=(SearchArena&& t_other) noexcept = delete;
+
+        ~SearchArena() noexcept = default;
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        /**
+         * @brief Sets the size of the map; no cell is allocated yet.
+         * @param t_width The map width.
+         * @param t_height The map height.
+         */
+        void Resize(const int t_width, const int t_height)
+        {
+            m_cells.Resize(t_width, t_height, Cell());
+            m_generation = 0;
+        }
+
+        /**
+         * @brief Starts a new search. All cells are unvisited afterwards.
+         */
+        void NewSearch()
+        {
+            m_generation++;
+
+            // on overflow the old stamps could become valid again
+            if (m_generation == 0)
+            {
+                m_cells.Reset();
+                m_generation = 1;
+            }
+        }
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * @brief Returns the number of cells.
+         * @return std::size_t
+         */
+        std::size_t GetSize() const noexcept { return m_cells.GetSize(); }
+
+        /**
+         * @brief Returns the memory of the cells touched so far in bytes.
+         * @return std::size_t
+         */
+        std::size_t GetMemoryUsage() const { return m_cells.GetMemoryUsage(); }
+
+        /**
+         * @brief Checks if a cell was written in the current search.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return bool
+         */
+        bool IsVisited(const CellIndex t_cellIndex) const
+        {
+            return FindVisited(t_cellIndex) != nullptr;
+        }
+
+        /**
+         * @brief Returns the distance from the start or `FLT_MAX` for an unvisited cell.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return float
+         */
+        float GetG(const CellIndex t_cellIndex) const
+        {
+            const auto* cell{ FindVisited(t_cellIndex) };
+
+            return cell ? cell->g : std::numeric_limits<float>::max();
+        }
+
+        /**
+         * @brief Returns the parent cell or `NO_PARENT`.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return CellIndex
+         */
+        CellIndex GetParent(const CellIndex t_cellIndex) const
+        {
+            const auto* cell{ FindVisited(t_cellIndex) };
+
+            return cell ? cell->parent : NO_PARENT;
+        }
+
+        /**
+         * @brief Returns the state of a cell.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return CellState
+         */
+        CellState GetState(const CellIndex t_cellIndex) const
+        {
+            const auto* cell{ FindVisited(t_cellIndex) };
+
+            return cell ? cell->state : CellState::UNVISITED;
+        }
+
+        /**
+         * @brief Checks if a cell is closed.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return bool
+         */
+        bool IsClosed(const CellIndex t_cellIndex) const
+        {
+            return GetState(t_cellIndex) == CellState::CLOSED;
+        }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * @brief Sets the distance and the parent of a cell and marks it as open.
+         * @param t_cellIndex The 1D index of the cell.
+         * @param t_g The distance from the start.
+         * @param t_parent The parent cell.
+         */
+        void Open(const CellIndex t_cellIndex, const float t_g, const CellIndex t_parent)
+        {
+            auto& cell{ Touch(t_cellIndex) };
+
+            cell.g = t_g;
+            cell.parent = t_parent;
+            cell.state = CellState::OPEN;
+        }
+
+        /**
+         * @brief Marks a cell as closed.
+         * @param t_cellIndex The 1D index of the cell.
+         */
+        void Close(const CellIndex t_cellIndex)
+        {
+            Touch(t_cellIndex).state = CellState::CLOSED;
+        }
+
+        /**
+         * @brief Sets only the parent of a cell.
+         * @param t_cellIndex The 1D index of the cell.
+         * @param t_parent The parent cell.
+         */
+        void SetParent(const CellIndex t_cellIndex, const CellIndex t_parent)
+        {
+            Touch(t_cellIndex).parent = t_parent;
+        }
+
+    protected:
+
+    private:
+        struct Cell
+        {
+            /**
+             * @brief The distance from the start.
+             */
+            float g{ std::numeric_limits<float>::max() };
+
+            CellIndex parent{ NO_PARENT };
+
+            /**
+             * @brief The generation in which the cell was written last.
+             */
+            Generation generation{ 0 };
+
+            CellState state{ CellState::UNVISITED };
+        };
+
+        PagedCells<Cell> m_cells;
+
+        /**
+         * @brief The generation of the current search.
+         */
+        Generation m_generation{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * @brief Returns a cell written in the current search.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return Pointer to the cell or nullptr.
+         */
+        const Cell* FindVisited(const CellIndex t_cellIndex) const
+        {
+            const auto* cell{ m_cells.Find(t_cellIndex) };
+
+            return cell && cell->generation == m_generation ? cell : nullptr;
+        }
+
+        /**
+         * @brief Resets a cell written in an older search.
+         * @param t_cellIndex The 1D index of the cell.
+         * @return Reference to the cell
+         */
+        Cell& Touch(const CellIndex t_cellIndex)
+        {
+            auto& cell{ m_cells.Get(t_cellIndex) };
+
+            if (cell.generation != m_generation)
+            {
+                cell = Cell();
+                cell.generation = m_generation;
+            }
+
+            return cell;
+        }
+    };
+}
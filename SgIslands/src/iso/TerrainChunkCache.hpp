@@ -0,0 +1,264 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: TerrainChunkCache.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include "TerrainMesh.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief Keeps the terrain of `TerrainMesh` chunks as pre-rendered images, so that a visible chunk
+     *        is drawn with one sprite instead of its tiles. A chunk is rendered again when the version
+     *        of its vertices has changed. If the images need more memory than the budget, the chunks
+     *        that were drawn last a long time ago are removed first.
+     *        The images hold premultiplied colors, because the tiles were already blended into them.
+     */
+    class TerrainChunkCache
+    {
+    public:
+        /**
+         * @brief The memory of the image of a full chunk without the parts of the tiles that stick out
+         *        above their field; a 32 x 32 chunk covers 2048 x 1024 pixels, so 8 MiB.
+         */
+        static constexpr std::size_t CHUNK_MEMORY{
+            static_cast<std::size_t>(TerrainMesh::CHUNK_SIZE * IsoMath::DEFAULT_TILE_WIDTH) *
+            static_cast<std::size_t>(TerrainMesh::CHUNK_SIZE * IsoMath::DEFAULT_TILE_HEIGHT) * 4
+        };
+
+        /**
+         * @brief Enough for the chunks visible in a full HD window, with some left for scrolling.
+         */
+        static constexpr std::size_t DEFAULT_NUMBER_OF_CHUNKS{ 16 };
+
+        static constexpr std::size_t DEFAULT_BUDGET{ DEFAULT_NUMBER_OF_CHUNKS * CHUNK_MEMORY };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates an empty cache.
+         * @param t_budget The maximum memory of the images in bytes.
+         */
+        explicit TerrainChunkCache(const std::size_t t_budget = DEFAULT_BUDGET)
+            : m_budget{ t_budget }
+        {}
+
+        TerrainChunkCache(const TerrainChunkCache& t_other) = delete;
+        TerrainChunkCache(TerrainChunkCache&& t_other) noexcept = delete;
+        TerrainChunkCache& operator=(const TerrainChunkCache& t_other) = delete;
+        TerrainChunkCache& operator=(TerrainChunkCache&& t_other) noexcept = delete;
+
+        ~TerrainChunkCache() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        std::size_t GetBudget() const noexcept { return m_budget; }
+
+        /**
+         * @brief Get the memory of all cached images in bytes.
+         * @return std::size_t
+         */
+        std::size_t GetMemoryUsage() const noexcept { return m_memoryUsage; }
+
+        std::size_t GetNumberOfCachedChunks() const noexcept { return m_entries.size(); }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * @brief Set the maximum memory of the images; the oldest chunks are removed at once if needed.
+         * @param t_budget The budget in bytes.
+         */
+        void SetBudget(const std::size_t t_budget)
+        {
+            m_budget = t_budget;
+            Evict(0);
+        }
+
+        void Clear()
+        {
+            m_entries.clear();
+            m_entriesByChunk.clear();
+            m_memoryUsage = 0;
+        }
+
+        //-------------------------------------------------
+        // Draw
+        //-------------------------------------------------
+
+        /**
+         * @brief Starts a new frame; the chunks drawn in the current frame are never removed.
+         */
+        void BeginFrame() noexcept
+        {
+            m_frame++;
+        }
+
+        /**
+         * @brief Draws a chunk from its image; a missing or outdated image is rendered first.
+         *        Without enough budget for the image, the chunk is drawn from its vertices.
+         * @param t_target The target to draw on.
+         * @param t_chunkIndex The index of the chunk in the `TerrainMesh`.
+         * @param t_chunk The vertices of the chunk.
+         * @param t_tileAtlas The atlas with the terrain tiles.
+         */
+        void Draw(sf::RenderTarget& t_target, const std::size_t t_chunkIndex, const TerrainMesh::Chunk& t_chunk, const TileAtlas& t_tileAtlas)
+        {
+            if (t_chunk.pages.empty())
+            {
+                return;
+            }
+
+            auto* entry{ GetEntry(t_chunkIndex, t_chunk, t_tileAtlas) };
+            if (!entry)
+            {
+                TerrainMesh::DrawChunk(t_target, t_tileAtlas, t_chunk);
+                return;
+            }
+
+            sf::Sprite sprite{ entry->renderTexture->getTexture() };
+            sprite.setPosition(entry->position);
+
+            // the alpha was already applied when the tiles were rendered into the image
+            t_target.draw(sprite, sf::RenderStates(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)));
+        }
+
+    protected:
+
+    private:
+        struct Entry
+        {
+            std::size_t chunkIndex{ 0 };
+            std::uint32_t version{ 0 };
+            std::uint32_t lastFrame{ 0 };
+
+            std::unique_ptr<sf::RenderTexture> renderTexture;
+            sf::Vector2f position;
+            std::size_t memory{ 0 };
+        };
+
+        using Entries = std::list<Entry>;
+
+        std::size_t m_budget{ DEFAULT_BUDGET };
+        std::size_t m_memoryUsage{ 0 };
+
+        std::uint32_t m_frame{ 0 };
+
+        /**
+         * @brief The cached chunks; the chunk drawn last is at the front.
+         */
+        Entries m_entries;
+
+        std::unordered_map<std::size_t, Entries::iterator> m_entriesByChunk;
+
+        /**
+         * @brief Finds or renders the image of a chunk and marks it as used in this frame.
+         * @return Entry* or nullptr if the image does not fit into the budget.
+         */
+        Entry* GetEntry(const std::size_t t_chunkIndex, const TerrainMesh::Chunk& t_chunk, const TileAtlas& t_tileAtlas)
+        {
+            const auto it{ m_entriesByChunk.find(t_chunkIndex) };
+
+            if (it != m_entriesByChunk.end())
+            {
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+                auto& entry{ m_entries.front() };
+                entry.lastFrame = m_frame;
+
+                if (entry.version != t_chunk.version)
+                {
+                    Remove(it);
+                    return GetEntry(t_chunkIndex, t_chunk, t_tileAtlas);
+                }
+
+                return &entry;
+            }
+
+            const auto left{ std::floor(t_chunk.bounds.left) };
+            const auto top{ std::floor(t_chunk.bounds.top) };
+            const auto width{ static_cast<unsigned>(std::ceil(t_chunk.bounds.left + t_chunk.bounds.width - left)) };
+            const auto height{ static_cast<unsigned>(std::ceil(t_chunk.bounds.top + t_chunk.bounds.height - top)) };
+            const auto memory{ static_cast<std::size_t>(width) * height * 4 };
+
+            if (!Evict(memory))
+            {
+                return nullptr;
+            }
+
+            auto renderTexture{ std::make_unique<sf::RenderTexture>() };
+            if (!renderTexture->create(width, height))
+            {
+                return nullptr;
+            }
+
+            // move the chunk to the origin of the image
+            sf::RenderStates states;
+            states.transform.translate(-left, -top);
+
+            renderTexture->clear(sf::Color::Transparent);
+            TerrainMesh::DrawChunk(*renderTexture, t_tileAtlas, t_chunk, states);
+            renderTexture->display();
+
+            m_entries.push_front({ t_chunkIndex, t_chunk.version, m_frame, std::move(renderTexture), sf::Vector2f(left, top), memory });
+            m_entriesByChunk.emplace(t_chunkIndex, m_entries.begin());
+            m_memoryUsage += memory;
+
+            return &m_entries.front();
+        }
+
+        void Remove(const std::unordered_map<std::size_t, Entries::iterator>::iterator t_it)
+        {
+            m_memoryUsage -= t_it->second->memory;
+            m_entries.erase(t_it->second);
+            m_entriesByChunk.erase(t_it);
+        }
+
+        /**
+         * @brief Removes the least recently drawn chunks until the given memory is free.
+         *        Chunks drawn in the current frame are kept.
+         * @param t_memory The memory needed in bytes.
+         * @return bool False if the memory could not be freed. Nothing is removed for more memory than the budget.
+         */
+        bool Evict(const std::size_t t_memory)
+        {
+            // the image would never fit, so the other images are kept
+            if (t_memory > m_budget)
+            {
+                return false;
+            }
+
+            while (m_memoryUsage + t_memory > m_budget)
+            {
+                if (m_entries.empty() || m_entries.back().lastFrame == m_frame)
+                {
+                    return false;
+                }
+
+                Remove(m_entriesByChunk.find(m_entries.back().chunkIndex));
+            }
+
+            return true;
+        }
+    };
+}
@@ -0,0 +1,293 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: TerrainMesh.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "MapFieldChunks.hpp"
+#include "TileAtlas.hpp"
+#include "IsoMath.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief The quads of the terrain tiles with their atlas texture coordinates.
+     *        The map is split into chunks of the size of a `MapChunk`; each chunk keeps one
+     *        vertex array for each atlas page it uses, so a chunk is drawn with one call per page.
+     *        The vertices of a chunk are only built again after one of its fields was invalidated.
+     */
+    class TerrainMesh
+    {
+    public:
+        static constexpr auto CHUNK_SIZE{ MapChunk::SIZE };
+
+        /**
+         * @brief The vertices of a chunk, one array for each atlas page.
+         */
+        using PageVertices = std::map<std::size_t, sf::VertexArray>;
+
+        struct Chunk
+        {
+            PageVertices pages;
+
+            /**
+             * @brief The screen area of the quads.
+             */
+            sf::FloatRect bounds;
+
+            /**
+             * @brief Incremented with each build, so that copies of the vertices can see a change.
+             */
+            std::uint32_t version{ 0 };
+
+            bool outdated{ true };
+        };
+
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        TerrainMesh() = default;
+
+        TerrainMesh(const TerrainMesh& t_other) = delete;
+        TerrainMesh(TerrainMesh&& t_other) noexcept = delete;
+        TerrainMesh& operator=(const TerrainMesh& t_other) = delete;
+        TerrainMesh& operator=(TerrainMesh&& t_other) noexcept = delete;
+
+        ~TerrainMesh() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        int GetNumberOfChunksX() const noexcept { return m_chunksX; }
+        int GetNumberOfChunksY() const noexcept { return m_chunksY; }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates the chunks for the given map size; all chunks must be built.
+         * @param t_mapWidth The map width in default tiles.
+         * @param t_mapHeight The map height in default tiles.
+         */
+        void Resize(const int t_mapWidth, const int t_mapHeight)
+        {
+            m_mapWidth = t_mapWidth;
+            m_mapHeight = t_mapHeight;
+
+            m_chunksX = (t_mapWidth + CHUNK_SIZE - 1) / CHUNK_SIZE;
+            m_chunksY = (t_mapHeight + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+            m_chunks.clear();
+            m_chunks.resize(static_cast<std::size_t>(m_chunksX * m_chunksY));
+        }
+
+        /**
+         * @brief Marks the chunk with the given map field, so that its vertices are built before the next draw.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         */
+        void Invalidate(const int t_mapX, const int t_mapY)
+        {
+            assert(t_mapX >= 0 && t_mapY >= 0 && t_mapX < m_mapWidth && t_mapY < m_mapHeight);
+
+            m_chunks[GetChunkIndex(t_mapX / CHUNK_SIZE, t_mapY / CHUNK_SIZE)].outdated = true;
+        }
+
+        //-------------------------------------------------
+        // Draw
+        //-------------------------------------------------
+
+        /**
+         * @brief Draws the terrain of the chunks in a map area.
+         * @param t_target The target to draw on.
+         * @param t_fields The map fields with the terrain tile ids.
+         * @param t_tileAtlas The atlas with the terrain tiles.
+         * @param t_mapArea The visible map area, clipped to the map.
+         */
+        void DrawTerrain(sf::RenderTarget& t_target, const MapFieldChunks& t_fields, const TileAtlas& t_tileAtlas, const sf::IntRect& t_mapArea)
+        {
+            ForEachChunk(t_fields, t_tileAtlas, t_mapArea, [&t_target, &t_tileAtlas](std::size_t, const Chunk& t_chunk)
+            {
+                DrawChunk(t_target, t_tileAtlas, t_chunk);
+            });
+        }
+
+        /**
+         * @brief Draws the vertices of a chunk.
+         * @param t_target The target to draw on.
+         * @param t_tileAtlas The atlas with the terrain tiles.
+         * @param t_chunk The chunk.
+         * @param t_states The render states for the vertices; the texture is set for each page.
+         */
+        static void DrawChunk(sf::RenderTarget& t_target, const TileAtlas& t_tileAtlas, const Chunk& t_chunk, const sf::RenderStates& t_states = sf::RenderStates::Default)
+        {
+            DrawPages(t_target, t_tileAtlas, t_chunk.pages, t_states);
+        }
+
+        //-------------------------------------------------
+        // Chunks
+        //-------------------------------------------------
+
+        /**
+         * @brief Calls a function with each chunk in a map area; outdated chunks are built first.
+         * @param t_fields The map fields with the terrain tile ids.
+         * @param t_tileAtlas The atlas with the terrain tiles.
+         * @param t_mapArea The map area, clipped to the map.
+         * @param t_function Gets the index and the `Chunk`.
+         */
+        template <typename T>
+        void ForEachChunk(const MapFieldChunks& t_fields, const TileAtlas& t_tileAtlas, const sf::IntRect& t_mapArea, T&& t_function)
+        {
+            if (t_mapArea.width <= 0 || t_mapArea.height <= 0)
+            {
+                return;
+            }
+
+            const auto chunkXEnd{ (t_mapArea.left + t_mapArea.width - 1) / CHUNK_SIZE };
+            const auto chunkYEnd{ (t_mapArea.top + t_mapArea.height - 1) / CHUNK_SIZE };
+
+            for (auto chunkY{ t_mapArea.top / CHUNK_SIZE }; chunkY <= chunkYEnd; ++chunkY)
+            {
+                for (auto chunkX{ t_mapArea.left / CHUNK_SIZE }; chunkX <= chunkXEnd; ++chunkX)
+                {
+                    const auto chunkIndex{ GetChunkIndex(chunkX, chunkY) };
+                    auto& chunk{ m_chunks[chunkIndex] };
+
+                    if (chunk.outdated)
+                    {
+                        BuildChunk(chunk, chunkX, chunkY, t_fields, t_tileAtlas);
+                    }
+
+                    t_function(chunkIndex, static_cast<const Chunk&>(chunk));
+                }
+            }
+        }
+
+    protected:
+
+    private:
+        int m_mapWidth{ 0 };
+        int m_mapHeight{ 0 };
+
+        int m_chunksX{ 0 };
+        int m_chunksY{ 0 };
+
+        std::vector<Chunk> m_chunks;
+
+        std::size_t GetChunkIndex(const int t_chunkX, const int t_chunkY) const
+        {
+            return static_cast<std::size_t>(t_chunkY * m_chunksX + t_chunkX);
+        }
+
+        //-------------------------------------------------
+        // Build
+        //-------------------------------------------------
+
+        /**
+         * @brief Creates the quads of the land fields of a chunk in the order the islands were drawn: row by row.
+         */
+        void BuildChunk(Chunk& t_chunk, const int t_chunkX, const int t_chunkY, const MapFieldChunks& t_fields, const TileAtlas& t_tileAtlas) const
+        {
+            t_chunk.pages.clear();
+
+            const auto xEnd{ std::min((t_chunkX + 1) * CHUNK_SIZE, m_mapWidth) };
+            const auto yEnd{ std::min((t_chunkY + 1) * CHUNK_SIZE, m_mapHeight) };
+
+            for (auto y{ t_chunkY * CHUNK_SIZE }; y < yEnd; ++y)
+            {
+                for (auto x{ t_chunkX * CHUNK_SIZE }; x < xEnd; ++x)
+                {
+                    if (!t_fields.IsLand(x, y))
+                    {
+                        continue;
+                    }
+
+                    // the tileset ids start with 0, the ids of the island files with 1
+                    const auto& tile{ t_tileAtlas.GetTerrainTile(t_fields.GetTerrainTileId(x, y) - 1) };
+
+                    auto screenPosition{ IsoMath::ToScreen(x, y) };
+
+                    // adjust "origin" of the isometric
+                    screenPosition.x -= IsoMath::DEFAULT_TILE_WIDTH_HALF;
+
+                    AppendQuad(t_chunk.pages, tile, screenPosition);
+                }
+            }
+
+            t_chunk.bounds = GetBounds(t_chunk.pages);
+            t_chunk.version++;
+            t_chunk.outdated = false;
+        }
+
+        /**
+         * @brief Adds a quad with the size of the tile image at the given screen position.
+         */
+        static void AppendQuad(PageVertices& t_pages, const core::TextureRegion& t_tile, const sf::Vector2f& t_position)
+        {
+            auto& vertices{ t_pages.try_emplace(t_tile.page, sf::Quads).first->second };
+
+            const auto left{ static_cast<float>(t_tile.rect.left) };
+            const auto top{ static_cast<float>(t_tile.rect.top) };
+            const auto width{ static_cast<float>(t_tile.rect.width) };
+            const auto height{ static_cast<float>(t_tile.rect.height) };
+
+            vertices.append(sf::Vertex(t_position, sf::Vector2f(left, top)));
+            vertices.append(sf::Vertex(sf::Vector2f(t_position.x + width, t_position.y), sf::Vector2f(left + width, top)));
+            vertices.append(sf::Vertex(sf::Vector2f(t_position.x + width, t_position.y + height), sf::Vector2f(left + width, top + height)));
+            vertices.append(sf::Vertex(sf::Vector2f(t_position.x, t_position.y + height), sf::Vector2f(left, top + height)));
+        }
+
+        static sf::FloatRect GetBounds(const PageVertices& t_pages)
+        {
+            sf::FloatRect bounds;
+
+            for (const auto& [page, vertices] : t_pages)
+            {
+                const auto pageBounds{ vertices.getBounds() };
+
+                if (bounds.width <= 0.0f || bounds.height <= 0.0f)
+                {
+                    bounds = pageBounds;
+                    continue;
+                }
+
+                const auto left{ std::min(bounds.left, pageBounds.left) };
+                const auto top{ std::min(bounds.top, pageBounds.top) };
+                const auto right{ std::max(bounds.left + bounds.width, pageBounds.left + pageBounds.width) };
+                const auto bottom{ std::max(bounds.top + bounds.height, pageBounds.top + pageBounds.height) };
+
+                bounds = sf::FloatRect(left, top, right - left, bottom - top);
+            }
+
+            return bounds;
+        }
+
+        static void DrawPages(sf::RenderTarget& t_target, const TileAtlas& t_tileAtlas, const PageVertices& t_pages, const sf::RenderStates& t_states = sf::RenderStates::Default)
+        {
+            for (const auto& [page, vertices] : t_pages)
+            {
+                auto states{ t_states };
+                states.texture = &t_tileAtlas.GetTexture(page);
+
+                t_target.draw(vertices, states);
+            }
+        }
+    };
+}
@@ -2,7 +2,7 @@
 // 
 // Filename: TileAtlas.hpp
 // Created:  20.01.2019
-// Updated:  15.03.2019
+// Updated:  16.10.2026
 // Author:   stwe
 // 
 // License:  MIT
@@ -11,9 +11,15 @@
 
 #pragma once
 
+#include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Sprite.hpp>
+#include <future>
+#include <map>
+#include <vector>
 #include "../core/XmlWrapper.hpp"
-#include "../core/ResourceHolder.hpp"
+#include "../core/TextureAtlas.hpp"
+#include "../core/ThreadPool.hpp"
+#include "../core/Types.hpp"
 #include "IsoMath.hpp"
 
 namespace sg::islands::iso
@@ -21,7 +27,7 @@ namespace sg::islands::iso
     class TileAtlas
     {
     public:
-        using TileId = int;
+        using TileId = core::TileId;
 
         //-------------------------------------------------
         // Known Ids
@@ -53,15 +59,34 @@ namespace sg::islands::iso
 
         TileAtlas() = delete;
 
+        /**
+         * @brief Loads the three tilesets.
+         * @param t_filenameBackgroundTileset The background tileset config file.
+         * @param t_filenameTerrainTileset The terrain tileset config file.
+         * @param t_filenameMiscTileset The misc tileset config file.
+         * @param t_threadPool Decodes the images of all tilesets at once; the atlas textures are
+         *                     always created on the calling thread, which owns the GL context.
+         */
         TileAtlas(
             const core::Filename& t_filenameBackgroundTileset,
             const core::Filename& t_filenameTerrainTileset,
-            const core::Filename& t_filenameMiscTileset
+            const core::Filename& t_filenameMiscTileset,
+            core::ThreadPool* const t_threadPool = nullptr
         )
         {
-            LoadTilesetFromFile(t_filenameBackgroundTileset, m_backgroundTileset);
-            LoadTilesetFromFile(t_filenameTerrainTileset, m_terrainTileset);
-            LoadTilesetFromFile(t_filenameMiscTileset, m_miscTileset);
+            auto backgroundImages{ DecodeTilesetFromFile(t_filenameBackgroundTileset, t_threadPool) };
+            auto terrainImages{ DecodeTilesetFromFile(t_filenameTerrainTileset, t_threadPool) };
+            auto miscImages{ DecodeTilesetFromFile(t_filenameMiscTileset, t_threadPool) };
+
+            PackTileset(backgroundImages, m_backgroundTiles);
+            PackTileset(terrainImages, m_terrainTiles);
+            PackTileset(miscImages, m_miscTiles);
+
+            m_textureAtlas.CreateTextures();
+            m_textureAtlas.ReleaseImages();
+
+            SG_ISLANDS_INFO("[TileAtlas::TileAtlas()] Packed {} tiles into {} atlas pages.",
+                m_backgroundTiles.size() + m_terrainTiles.size() + m_miscTiles.size(), m_textureAtlas.GetNumberOfPages());
         }
 
         TileAtlas(const TileAtlas& t_other) = delete;
@@ -76,33 +101,43 @@ namespace sg::islands::iso
         //-------------------------------------------------
 
         /**
-         * @brief Returns the deep water background texture to the passed tile id.
+         * @brief Returns the atlas region of a deep water background tile.
          * @param t_tileId A tile id.
-         * @return Const reference to sf::Texture
+         * @return Const reference to `TextureRegion`
          */
-        const sf::Texture& GetBackgroundTileGraphic(const TileId t_tileId) const
+        const core::TextureRegion& GetBackgroundTile(const TileId t_tileId) const
         {
-            return m_backgroundTileset.GetResource(t_tileId);
+            return GetTile(m_backgroundTiles, t_tileId);
         }
 
         /**
-         * @brief Returns the terrain texture to the passed tile id.
+         * @brief Returns the atlas region of a terrain tile.
          * @param t_tileId A tile id.
-         * @return Const reference to sf::Texture
+         * @return Const reference to `TextureRegion`
          */
-        const sf::Texture& GetTerrainTileGraphic(const TileId t_tileId) const
+        const core::TextureRegion& GetTerrainTile(const TileId t_tileId) const
         {
-            return m_terrainTileset.GetResource(t_tileId);
+            return GetTile(m_terrainTiles, t_tileId);
         }
 
         /**
-         * @brief Returns the texture to the passed tile id.
+         * @brief Returns the atlas region of a misc tile.
          * @param t_tileId A tile id.
-         * @return Const reference to sf::Texture
+         * @return Const reference to `TextureRegion`
+         */
+        const core::TextureRegion& GetMiscTile(const TileId t_tileId) const
+        {
+            return GetTile(m_miscTiles, t_tileId);
+        }
+
+        /**
+         * @brief Returns the texture of an atlas page.
+         * @param t_page The page of a `TextureRegion`.
+         * @return Const reference to `sf::Texture`
          */
-        const sf::Texture& GetMiscTileGraphic(const TileId t_tileId) const
+        const sf::Texture& GetTexture(const std::size_t t_page) const
         {
-            return m_miscTileset.GetResource(t_tileId);
+            return m_textureAtlas.GetTexture(t_page);
         }
 
         //-------------------------------------------------
@@ -121,10 +156,9 @@ namespace sg::islands::iso
             sf::RenderWindow& t_window
         ) const
         {
-            const auto& deepWaterSouth{ GetBackgroundTileGraphic(DEEP_WATER_SOUTH_TILE) };
+            const auto& deepWaterSouth{ GetBackgroundTile(DEEP_WATER_SOUTH_TILE) };
 
-            sf::Sprite sprite;
-            sprite.setTexture(deepWaterSouth);
+            sf::Sprite sprite{ GetTexture(deepWaterSouth.page), deepWaterSouth.rect };
 
             auto screenPosition{ IsoMath::ToScreen(t_xMapPos, t_yMapPos, false, IsoMath::DEEP_WATER_TILE_WIDTH_HALF, IsoMath::DEEP_WATER_TILE_HEIGHT_HALF) };
 
@@ -150,8 +184,7 @@ namespace sg::islands::iso
             sf::RenderWindow& t_window
         ) const
         {
-            const auto& texture{ GetTerrainTileGraphic(t_tileId) };
-            DrawTile(t_xMapPos, t_yMapPos, texture, t_window);
+            DrawTile(t_xMapPos, t_yMapPos, GetTerrainTile(t_tileId), t_window);
         }
 
         /**
@@ -168,29 +201,45 @@ namespace sg::islands::iso
             sf::RenderWindow& t_window
         ) const
         {
-            const auto& texture{ GetMiscTileGraphic(t_tileId) };
-            DrawTile(t_xMapPos, t_yMapPos, texture, t_window);
+            DrawTile(t_xMapPos, t_yMapPos, GetMiscTile(t_tileId), t_window);
         }
 
     protected:
 
     private:
-        core::Tileset m_backgroundTileset;
-        core::Tileset m_terrainTileset;
-        core::Tileset m_miscTileset;
+        using Tiles = std::map<TileId, core::TextureRegion>;
+
+        /**
+         * @brief The images of all three tilesets.
+         */
+        core::TextureAtlas m_textureAtlas;
+
+        Tiles m_backgroundTiles;
+        Tiles m_terrainTiles;
+        Tiles m_miscTiles;
 
         //-------------------------------------------------
         // Load Data
         //-------------------------------------------------
 
         /**
-         * @brief Add textures to the tile atlas.
+         * @brief An image of a tileset, decoded on a worker thread.
+         */
+        struct TileImage
+        {
+            int tileId;
+            std::future<sf::Image> image;
+        };
+
+        /**
+         * @brief Reads a tileset config and starts decoding its images.
          * @param t_filename The given xml config file.
-         * @param t_tileset The loaded textures.
+         * @param t_threadPool The pool to decode the images or nullptr.
+         * @return std::vector<TileImage>
          */
-        void LoadTilesetFromFile(const core::Filename& t_filename, core::Tileset& t_tileset) const
+        static std::vector<TileImage> DecodeTilesetFromFile(const core::Filename& t_filename, core::ThreadPool* const t_threadPool)
         {
-            SG_ISLANDS_INFO("[TileAtlas::LoadTilesetFromFile()] Open {} to add textures to the tile atlas.", t_filename);
+            SG_ISLANDS_INFO("[TileAtlas::DecodeTilesetFromFile()] Open {} to add textures to the tile atlas.", t_filename);
 
             tinyxml2::XMLDocument document;
 
@@ -200,7 +249,7 @@ namespace sg::islands::iso
             // get `<tileset>` element
             const auto tilesetElement{core::XmlWrapper::GetFirstChildElement(document, "tileset") };
 
-            SG_ISLANDS_INFO("[TileAtlas::LoadTilesetFromFile()] Loading tileset ...");
+            std::vector<TileImage> tileImages;
 
             // get each `<tile>`
             for (auto tile{ tilesetElement->FirstChildElement("tile") }; tile != nullptr; tile = tile->NextSiblingElement())
@@ -215,11 +264,46 @@ namespace sg::islands::iso
                 // read path
                 auto pathAttr{ core::XmlWrapper::GetAttribute(imageElement, "path") };
 
-                // load and add texture
-                t_tileset.Load(idAttr, pathAttr);
+                // decode image
+                tileImages.push_back({ idAttr, core::ThreadPool::EnqueueOrDefer(t_threadPool, [pathAttr]()
+                {
+                    sf::Image image;
+                    if (!image.loadFromFile(pathAttr))
+                    {
+                        THROW_SG_EXCEPTION("[TileAtlas::DecodeTilesetFromFile()] Failed to load image " + pathAttr);
+                    }
+
+                    return image;
+                }) });
+            }
+
+            return tileImages;
+        }
+
+        /**
+         * @brief Packs the images of a tileset into the atlas.
+         * @param t_tileImages The decoded images.
+         * @param t_tiles Gets the atlas regions of the tiles.
+         */
+        void PackTileset(std::vector<TileImage>& t_tileImages, Tiles& t_tiles)
+        {
+            for (auto& tileImage : t_tileImages)
+            {
+                t_tiles.emplace(tileImage.tileId, m_textureAtlas.Add(tileImage.image.get()));
+            }
+
+            SG_ISLANDS_INFO("[TileAtlas::PackTileset()] Successfully packed {} tiles.", t_tiles.size());
+        }
+
+        static const core::TextureRegion& GetTile(const Tiles& t_tiles, const TileId t_tileId)
+        {
+            const auto it{ t_tiles.find(t_tileId) };
+            if (it == t_tiles.end())
+            {
+                THROW_SG_EXCEPTION("[TileAtlas::GetTile()] Invalid tile id " + std::to_string(t_tileId));
             }
 
-            SG_ISLANDS_INFO("[TileAtlas::LoadTilesetFromFile()] Successfully loaded {} textures.", t_tileset.GetNumberOfElements());
+            return it->second;
         }
 
         //-------------------------------------------------
@@ -230,20 +314,19 @@ namespace sg::islands::iso
          * @brief Draws a tile.
          * @param t_xMapPos The x-map position.
          * @param t_yMapPos The y-map position.
-         * @param t_texture Const reference to a `sf::Texture`.
+         * @param t_tile The atlas region of the tile.
          * @param t_window Reference to the `RenderWindow`.
          */
         void DrawTile(
             const int t_xMapPos,
             const int t_yMapPos,
-            const sf::Texture& t_texture,
+            const core::TextureRegion& t_tile,
             sf::RenderWindow& t_window
         ) const
         {
             auto screenPosition{ IsoMath::ToScreen(t_xMapPos, t_yMapPos) };
 
-            sf::Sprite sprite;
-            sprite.setTexture(t_texture);
+            sf::Sprite sprite{ GetTexture(t_tile.page), t_tile.rect };
 
             // adjust "origin" of the isometric
             screenPosition.x -= IsoMath::DEFAULT_TILE_WIDTH_HALF;
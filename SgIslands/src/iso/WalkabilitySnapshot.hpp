@@ -0,0 +1,186 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: WalkabilitySnapshot.hpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#pragma once
+
+#include <cstdint>
+#include "Map.hpp"
+
+namespace sg::islands::iso
+{
+    /**
+     * @brief An immutable copy of the walkability, the clearance and the connected regions of a `Map`.
+     *        Nothing is copied field by field; the snapshot shares the chunks of the map fields, the
+     *        labels and the clearances with the `Map`, which copies a shared chunk before changing it.
+     *        A snapshot must be taken in the game thread.
+     *        Worker threads search on a snapshot while the game thread keeps changing the `Map`.
+     */
+    class WalkabilitySnapshot
+    {
+    public:
+        //-------------------------------------------------
+        // Ctor. && Dtor.
+        //-------------------------------------------------
+
+        WalkabilitySnapshot() = delete;
+
+        explicit WalkabilitySnapshot(const Map& t_map)
+            : m_mapWidth{ t_map.GetMapWidth() }
+            , m_mapHeight{ t_map.GetMapHeight() }
+            , m_version{ t_map.GetVersion() }
+            , m_fields{ t_map.GetFields() }
+            , m_waterLabels{ t_map.GetComponents(AssetType::WATER_UNIT).GetLabels() }
+            , m_landLabels{ t_map.GetComponents(AssetType::LAND_UNIT).GetLabels() }
+            , m_waterClearances{ t_map.GetClearance(AssetType::WATER_UNIT).GetClearances() }
+            , m_landClearances{ t_map.GetClearance(AssetType::LAND_UNIT).GetClearances() }
+            , m_waterLandmarks{ t_map.GetLandmarkTable(AssetType::WATER_UNIT) }
+            , m_landLandmarks{ t_map.GetLandmarkTable(AssetType::LAND_UNIT) }
+        {}
+
+        WalkabilitySnapshot(const WalkabilitySnapshot& t_other) = delete;
+        WalkabilitySnapshot(WalkabilitySnapshot&& t_other) noexcept = delete;
+        WalkabilitySnapshot& operator=(const WalkabilitySnapshot& t_other) = delete;
+        WalkabilitySnapshot& operator=(WalkabilitySnapshot&& t_other) noexcept = delete;
+
+        ~WalkabilitySnapshot() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        auto GetMapWidth() const { return m_mapWidth; }
+
+        auto GetMapHeight() const { return m_mapHeight; }
+
+        /**
+         * @brief Get the `Map` version from which the snapshot was taken.
+         * @return std::uint32_t
+         */
+        auto GetVersion() const { return m_version; }
+
+        /**
+         * @brief Checks if the `Map` or its landmark tables have changed since the snapshot was taken.
+         * @param t_map The `Map`.
+         * @return bool
+         */
+        bool IsOutdated(const Map& t_map) const
+        {
+            return m_version != t_map.GetVersion() ||
+                m_waterLandmarks != t_map.GetLandmarkTable(AssetType::WATER_UNIT) ||
+                m_landLandmarks != t_map.GetLandmarkTable(AssetType::LAND_UNIT);
+        }
+
+        /**
+         * @brief Get the landmark distances for the given type of unit.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return const LandmarkTable* or nullptr if the landmarks were disabled.
+         */
+        const LandmarkTable* GetLandmarks(const AssetType t_assetType) const
+        {
+            return t_assetType == AssetType::WATER_UNIT ? m_waterLandmarks.get() : m_landLandmarks.get();
+        }
+
+        /**
+         * @brief Checks if a unit of the given type can enter the target.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return bool
+         */
+        bool IsWalkable(const int t_mapX, const int t_mapY, const AssetType t_assetType) const
+        {
+            if (t_mapX < 0 || t_mapY < 0 || t_mapX >= m_mapWidth || t_mapY >= m_mapHeight)
+            {
+                return false;
+            }
+
+            return m_fields.IsWalkable(t_mapX, t_mapY, t_assetType);
+        }
+
+        /**
+         * @brief Checks if a unit of the given type and size can stand on the target.
+         * @param t_mapX The x-map position.
+         * @param t_mapY The y-map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @param t_footprint The width and height of the unit in map fields; the unit is centered on the target.
+         * @return bool
+         */
+        bool IsWalkable(const int t_mapX, const int t_mapY, const AssetType t_assetType, const int t_footprint) const
+        {
+            if (t_footprint <= 1)
+            {
+                return IsWalkable(t_mapX, t_mapY, t_assetType);
+            }
+
+            const auto offset{ (t_footprint - 1) / 2 };
+            const auto x{ t_mapX - offset };
+            const auto y{ t_mapY - offset };
+
+            if (x < 0 || y < 0 || x >= m_mapWidth || y >= m_mapHeight)
+            {
+                return false;
+            }
+
+            const auto& clearances{ t_assetType == AssetType::WATER_UNIT ? m_waterClearances : m_landClearances };
+
+            return clearances.Get(x, y) >= t_footprint;
+        }
+
+        /**
+         * @brief Checks if a unit of the given type can get from one position to another.
+         * @param t_from The start map position.
+         * @param t_to The target map position.
+         * @param t_assetType The type of the unit (`WATER_UNIT` or `LAND_UNIT`).
+         * @return bool
+         */
+        bool IsReachable(const sf::Vector2i& t_from, const sf::Vector2i& t_to, const AssetType t_assetType) const
+        {
+            if (!IsWalkable(t_from.x, t_from.y, t_assetType) || !IsWalkable(t_to.x, t_to.y, t_assetType))
+            {
+                return false;
+            }
+
+            const auto& labels{ t_assetType == AssetType::WATER_UNIT ? m_waterLabels : m_landLabels };
+
+            return labels.Get(t_from.x, t_from.y) == labels.Get(t_to.x, t_to.y);
+        }
+
+    protected:
+
+    private:
+        int m_mapWidth{ 0 };
+        int m_mapHeight{ 0 };
+        std::uint32_t m_version{ 0 };
+
+        /**
+         * @brief The map fields of the `Map`.
+         */
+        MapFieldChunks m_fields;
+
+        /**
+         * @brief The connected region per map field.
+         */
+        ChunkedGrid<ConnectedComponents::Label> m_waterLabels;
+        ChunkedGrid<ConnectedComponents::Label> m_landLabels;
+
+        /**
+         * @brief The clearance per map field.
+         */
+        ChunkedGrid<ClearanceMap::Clearance> m_waterClearances;
+        ChunkedGrid<ClearanceMap::Clearance> m_landClearances;
+
+        /**
+         * @brief The landmark tables of the `Map`; shared, because a built table is not changed.
+         */
+        LandmarkTableSharedPtr m_waterLandmarks;
+        LandmarkTableSharedPtr m_landLandmarks;
+    };
+}
@@ -0,0 +1,90 @@
+// This file is part of the SgIslands package.
+// 
+// Filename: MapCompiler.cpp
+// Created:  16.10.2026
+// Updated:  16.10.2026
+// Author:   stwe
+// 
+// License:  MIT
+// 
+// 2019 (c) stwe <https://github.com/stwe/SgIslands>
+
+#define _USE_MATH_DEFINES
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "../src/core/SgException.hpp"
+#include "../src/core/Log.hpp"
+#include "../src/core/Types.hpp"
+#include "../src/core/XmlWrapper.hpp"
+#include "../src/iso/Island.hpp"
+#include "../src/iso/MapFormat.hpp"
+
+/**
+ * @brief Compiles a map xml file and its island xml files into one `.sgmap` file.
+ *        Only the xml files are read; no `Map` is created, so no window or texture is needed.
+ *        Usage: SgIslandsMapCompiler <map.xml> <map.sgmap>
+ */
+int main(const int t_argc, char** t_argv)
+{
+    using namespace sg::islands;
+
+    core::Log::Init();
+
+    if (t_argc != 3)
+    {
+        std::printf("Usage: %s <map.xml> <map%s>\n", t_argv[0], iso::MapFormat::FILE_EXTENSION);
+        return 1;
+    }
+
+    try
+    {
+        tinyxml2::XMLDocument document;
+        core::XmlWrapper::LoadXmlFile(t_argv[1], document);
+
+        // get `<map>` element
+        const auto mapElement{ core::XmlWrapper::GetFirstChildElement(document, "map") };
+
+        int deepWaterWidth;
+        core::XmlWrapper::QueryAttribute(mapElement, "deep_water_width", &deepWaterWidth);
+
+        int deepWaterHeight;
+        core::XmlWrapper::QueryAttribute(mapElement, "deep_water_height", &deepWaterHeight);
+
+        // get `<islands>` element
+        const auto islandsElement{ core::XmlWrapper::GetFirstChildElement(mapElement, "islands") };
+
+        std::vector<iso::MapFileIslandData> islands;
+
+        for (auto islandElement{ islandsElement->FirstChildElement("island") }; islandElement != nullptr; islandElement = islandElement->NextSiblingElement())
+        {
+            const iso::Island island{ core::XmlWrapper::GetStringFromXmlElement(islandElement, "filename") };
+
+            iso::MapFileIslandData data;
+            core::XmlWrapper::QueryAttribute(islandElement, "x_map_pos", &data.xMapPos);
+            core::XmlWrapper::QueryAttribute(islandElement, "y_map_pos", &data.yMapPos);
+            data.width = island.GetWidth();
+            data.height = island.GetHeight();
+
+            data.tileIds.reserve(island.GetIslandFields().size());
+            for (const auto& islandField : island.GetIslandFields())
+            {
+                data.tileIds.push_back(islandField.tileId);
+            }
+
+            islands.push_back(std::move(data));
+        }
+
+        iso::MapFormat::Write(t_argv[2], deepWaterWidth, deepWaterHeight, islands);
+
+        SG_ISLANDS_INFO("[main()] Compiled {} islands into {}.", islands.size(), t_argv[2]);
+    }
+    catch (const std::exception& e)
+    {
+        SG_ISLANDS_ERROR("Exception: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}